@@ -0,0 +1,877 @@
+/* File: asyncreader.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Asynchronous file reader. See asyncreader.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -AsyncReader
+ *      3. io_uring Functions
+ *          -uringSetup
+ *          -uringClose
+ *          -uringSubmit
+ *          -uringReap
+ *      4. Thread Functions
+ *          -readSome
+ *          -readerThread
+ *          -startThreads
+ *      5. Utility Functions
+ *          -fallBack
+ *          -queueRead
+ *          -waitReady
+ *          -drain
+ *      6. AsyncReader Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "asyncreader.h"
+
+#ifdef __NR_io_uring_setup
+#include <linux/io_uring.h>
+#define ASYNC_HAVE_URING 1
+#else
+#define ASYNC_HAVE_URING 0
+#endif
+
+/* Buffer States */
+#define BUFFER_FREE 0
+#define BUFFER_QUEUED 1
+#define BUFFER_BUSY 2
+#define BUFFER_READY 3
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* AsyncReader
+ *
+ * Buffers are used in ring order: buffer head is the next one handed
+ * out, and reads are queued in the same order as buffers come back.
+ * Offsets, lengths and states are protected by lock in thread mode;
+ * in io_uring mode only the caller's thread touches them. Once the
+ * ring fails, the reads it did not complete are left BUFFER_BUSY until
+ * fallBack hands them to threads.
+ *
+ * @param   fd              open file
+ * @param   plainFd         the file without O_DIRECT, for reads at
+ *                          unaligned offsets (-1 = fd is plain)
+ * @param   seekable        1 for a regular file
+ * @param   size            file size (regular files only)
+ * @param   uring           1 = io_uring, 0 = threads
+ * @param   buffers         read buffers
+ * @param   offsets         file offset each buffer was read from
+ * @param   lengths         bytes read into each buffer (-1 = error)
+ * @param   states          BUFFER_FREE, _QUEUED, _BUSY or _READY
+ * @param   head            next buffer to hand out
+ * @param   current         buffer held by the caller (-1 = none)
+ * @param   claim           next buffer a thread should read into
+ * @param   nextOffset      offset the next queued read starts at
+ * @param   inflight        reads queued and not yet complete
+ * @param   failed          set when a read fails
+ * @param   uringError      set when a submission or a read through
+ *                          the ring fails
+ * @param   ring            io_uring file descriptor
+ * @param   sqMap           mapped submission ring
+ * @param   sqMapSize       size of sqMap
+ * @param   cqMap           mapped completion ring
+ * @param   cqMapSize       size of cqMap
+ * @param   sqes            mapped submission entries
+ * @param   sqesSize        size of sqes
+ * @param   sqTail          submission ring tail
+ * @param   sqMask          submission ring mask
+ * @param   sqArray         submission ring index array
+ * @param   cqHead          completion ring head
+ * @param   cqTail          completion ring tail
+ * @param   cqMask          completion ring mask
+ * @param   cqes            completion entries
+ * @param   numThreads      threads started (thread mode)
+ * @param   stop            set when the threads should exit
+ * @param   lock            protects the buffer fields in thread mode
+ * @param   wake            signalled when a buffer changes state
+ * @param   threads         reader threads
+ */
+
+struct AsyncReader_ {
+    int fd;
+    int plainFd;
+    int seekable;
+    long size;
+    int uring;
+    char* buffers[ASYNC_DEPTH];
+    long offsets[ASYNC_DEPTH];
+    long lengths[ASYNC_DEPTH];
+    int states[ASYNC_DEPTH];
+    int head;
+    int current;
+    int claim;
+    long nextOffset;
+    int inflight;
+    int failed;
+    int uringError;
+    int ring;
+    void* sqMap;
+    size_t sqMapSize;
+    void* cqMap;
+    size_t cqMapSize;
+    void* sqes;
+    size_t sqesSize;
+    unsigned* sqTail;
+    unsigned* sqMask;
+    unsigned* sqArray;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned* cqMask;
+    void* cqes;
+    int numThreads;
+    int stop;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t threads[ASYNC_THREADS];
+};
+
+/********************************
+ *    3. io_uring Functions     *
+ ********************************/
+
+/* uringSetup
+ *
+ * Creates a ring with room for every buffer and maps it. Returns 1 on
+ * success and 0 if io_uring is not available, which includes kernels
+ * that have rings but not IORING_OP_READ (before 5.6, where the probe
+ * itself is missing too).
+ */
+
+static int uringSetup(AsyncReader reader)
+{
+#if ASYNC_HAVE_URING
+    struct io_uring_params params;
+    struct io_uring_probe* probe;
+    size_t probeSize;
+    char* sq;
+    char* cq;
+    int ring, supported;
+
+    memset(&params, 0, sizeof(params));
+    ring = (int)syscall(__NR_io_uring_setup, ASYNC_DEPTH, &params);
+    if(ring < 0)
+    {
+        return 0;
+    }
+
+    probeSize = sizeof(struct io_uring_probe) + (IORING_OP_READ + 1) * sizeof(struct io_uring_probe_op);
+    probe = (struct io_uring_probe*)calloc(1, probeSize);
+    assert(probe != NULL);
+
+    supported = syscall(__NR_io_uring_register, ring, IORING_REGISTER_PROBE, probe, IORING_OP_READ + 1) >= 0 &&
+                probe->last_op >= IORING_OP_READ &&
+                (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) != 0;
+    free(probe);
+
+    if(!supported)
+    {
+        close(ring);
+        return 0;
+    }
+
+    reader->sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    reader->cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    reader->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    reader->sqMap = mmap(NULL, reader->sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+    reader->cqMap = mmap(NULL, reader->cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+    reader->sqes = mmap(NULL, reader->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+
+    if(reader->sqMap == MAP_FAILED || reader->cqMap == MAP_FAILED || reader->sqes == MAP_FAILED)
+    {
+        if(reader->sqMap != MAP_FAILED) munmap(reader->sqMap, reader->sqMapSize);
+        if(reader->cqMap != MAP_FAILED) munmap(reader->cqMap, reader->cqMapSize);
+        if(reader->sqes != MAP_FAILED) munmap(reader->sqes, reader->sqesSize);
+        close(ring);
+        return 0;
+    }
+
+    sq = (char*)reader->sqMap;
+    cq = (char*)reader->cqMap;
+
+    reader->ring = ring;
+    reader->sqTail = (unsigned*)(sq + params.sq_off.tail);
+    reader->sqMask = (unsigned*)(sq + params.sq_off.ring_mask);
+    reader->sqArray = (unsigned*)(sq + params.sq_off.array);
+    reader->cqHead = (unsigned*)(cq + params.cq_off.head);
+    reader->cqTail = (unsigned*)(cq + params.cq_off.tail);
+    reader->cqMask = (unsigned*)(cq + params.cq_off.ring_mask);
+    reader->cqes = cq + params.cq_off.cqes;
+
+    return 1;
+#else
+    (void)reader;
+    return 0;
+#endif
+}
+
+/* uringClose
+ *
+ * Unmaps and closes the ring.
+ */
+
+static void uringClose(AsyncReader reader)
+{
+    munmap(reader->sqMap, reader->sqMapSize);
+    munmap(reader->cqMap, reader->cqMapSize);
+    munmap(reader->sqes, reader->sqesSize);
+    close(reader->ring);
+}
+
+/* uringSubmit
+ *
+ * Submits a read of buffer b from offsets[b]. There are never more
+ * reads in flight than buffers, so the ring cannot be full. Returns 1
+ * if the kernel took the read and 0 if io_uring_enter failed.
+ */
+
+static int uringSubmit(AsyncReader reader, int b)
+{
+#if ASYNC_HAVE_URING
+    struct io_uring_sqe* sqe;
+    unsigned tail, index;
+    long submitted;
+
+    tail = *reader->sqTail;
+    index = tail & *reader->sqMask;
+
+    sqe = (struct io_uring_sqe*)reader->sqes + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = reader->fd;
+    sqe->off = (unsigned long)reader->offsets[b];
+    sqe->addr = (unsigned long)reader->buffers[b];
+    sqe->len = ASYNC_BUFFER_SIZE;
+    sqe->user_data = (unsigned long)b;
+
+    reader->sqArray[index] = index;
+    __atomic_store_n(reader->sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    do
+    {
+        submitted = syscall(__NR_io_uring_enter, reader->ring, 1, 0, 0, NULL, 0);
+    } while(submitted < 0 && errno == EINTR);
+
+    return submitted == 1;
+#else
+    (void)reader;
+    (void)b;
+    return 0;
+#endif
+}
+
+/* uringReap
+ *
+ * Waits for at least one read to complete and marks every completed
+ * buffer ready, or, if the read failed, notes the error and leaves the
+ * buffer busy for fallBack. Returns 1 if the wait worked and 0 if
+ * io_uring_enter failed.
+ */
+
+static int uringReap(AsyncReader reader)
+{
+#if ASYNC_HAVE_URING
+    struct io_uring_cqe* cqe;
+    unsigned head, tail;
+    long status;
+    int b;
+
+    do
+    {
+        status = syscall(__NR_io_uring_enter, reader->ring, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+    } while(status < 0 && errno == EINTR);
+
+    if(status < 0)
+    {
+        reader->uringError = 1;
+        return 0;
+    }
+
+    head = *reader->cqHead;
+    tail = __atomic_load_n(reader->cqTail, __ATOMIC_ACQUIRE);
+
+    while(head != tail)
+    {
+        cqe = (struct io_uring_cqe*)reader->cqes + (head & *reader->cqMask);
+        b = (int)cqe->user_data;
+
+        if(cqe->res < 0)
+        {
+            reader->uringError = 1;
+        }
+        else
+        {
+            reader->lengths[b] = (long)cqe->res;
+            reader->states[b] = BUFFER_READY;
+        }
+        reader->inflight--;
+        head++;
+    }
+
+    __atomic_store_n(reader->cqHead, head, __ATOMIC_RELEASE);
+
+    return 1;
+#else
+    (void)reader;
+    return 0;
+#endif
+}
+
+/********************************
+ *     4. Thread Functions      *
+ ********************************/
+
+/* readSome
+ *
+ * Reads whatever is available from a file that cannot seek, but at
+ * least minimum bytes unless the input ends first, retrying if
+ * interrupted.
+ */
+
+static long readSome(int fd, char* buffer, size_t length, long minimum)
+{
+    long total, n;
+
+    total = 0;
+
+    do
+    {
+        n = (long)read(fd, buffer + total, length - (size_t)total);
+        if(n > 0)
+        {
+            total += n;
+        }
+        else if(n == 0 || errno != EINTR)
+        {
+            break;
+        }
+    } while(total < minimum);
+
+    return (n < 0 && total == 0) ? -1 : total;
+}
+
+/* readerThread
+ *
+ * Reads queued buffers in ring order until told to stop.
+ */
+
+static void* readerThread(void* arg)
+{
+    AsyncReader reader;
+    int b;
+    long n;
+
+    reader = (AsyncReader)arg;
+
+    /* Only a read may be cancelled (see closeAsyncReader) */
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+
+    pthread_mutex_lock(&reader->lock);
+
+    for(;;)
+    {
+        while(!reader->stop && reader->states[reader->claim] != BUFFER_QUEUED)
+        {
+            pthread_cond_wait(&reader->wake, &reader->lock);
+        }
+
+        if(reader->stop)
+        {
+            break;
+        }
+
+        b = reader->claim;
+        reader->claim = (reader->claim + 1) % ASYNC_DEPTH;
+        reader->states[b] = BUFFER_BUSY;
+
+        /* Read without holding the lock so other threads can claim the
+           next buffer */
+        pthread_mutex_unlock(&reader->lock);
+
+        if(reader->seekable)
+        {
+            do
+            {
+                n = (long)pread(reader->fd, reader->buffers[b], ASYNC_BUFFER_SIZE, (off_t)reader->offsets[b]);
+            } while(n < 0 && errno == EINTR);
+        }
+        else
+        {
+            pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+
+            /* The first buffer has to hold any header, such as the
+               magic bytes of a binary trace */
+            n = readSome(reader->fd, reader->buffers[b], ASYNC_BUFFER_SIZE,
+                         (reader->offsets[b] == 0) ? ASYNC_HEADER : 1);
+
+            pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+        }
+
+        pthread_mutex_lock(&reader->lock);
+
+        reader->lengths[b] = n;
+        reader->states[b] = BUFFER_READY;
+        reader->inflight--;
+        pthread_cond_broadcast(&reader->wake);
+    }
+
+    pthread_mutex_unlock(&reader->lock);
+
+    return NULL;
+}
+
+/* startThreads
+ *
+ * Starts the reader threads: one for a file that cannot seek, whose
+ * reads have to happen in order, and ASYNC_THREADS otherwise.
+ */
+
+static void startThreads(AsyncReader reader)
+{
+    int t;
+
+    reader->numThreads = reader->seekable ? ASYNC_THREADS : 1;
+    for(t = 0; t < reader->numThreads; t++)
+    {
+        pthread_create(&reader->threads[t], NULL, readerThread, reader);
+    }
+}
+
+/********************************
+ *     5. Utility Functions     *
+ ********************************/
+
+/* fallBack
+ *
+ * Gives up on io_uring after a failure and switches to pread threads.
+ * Waits for the reads the kernel still holds, then queues every buffer
+ * not yet handed out again, in ring order, so the threads reread them
+ * whether or not the ring managed to. A real I/O error then shows up
+ * from pread.
+ */
+
+static void fallBack(AsyncReader reader)
+{
+    int i, b;
+
+    while(reader->inflight > 0 && uringReap(reader))
+    {
+    }
+
+    uringClose(reader);
+    reader->uring = 0;
+
+    reader->inflight = 0;
+    reader->claim = reader->head;
+
+    for(i = 0; i < ASYNC_DEPTH; i++)
+    {
+        b = (reader->head + i) % ASYNC_DEPTH;
+        if(b == reader->current || reader->states[b] == BUFFER_FREE)
+        {
+            break;
+        }
+
+        reader->states[b] = BUFFER_QUEUED;
+        reader->inflight++;
+    }
+
+    startThreads(reader);
+}
+
+/* queueRead
+ *
+ * Queues a read of the next part of the file into buffer b, or marks
+ * it free if the whole file has already been queued.
+ */
+
+static void queueRead(AsyncReader reader, int b)
+{
+    if(reader->seekable && reader->nextOffset >= reader->size)
+    {
+        reader->states[b] = BUFFER_FREE;
+        return;
+    }
+
+    reader->offsets[b] = reader->nextOffset;
+    reader->nextOffset += ASYNC_BUFFER_SIZE;
+
+    if(reader->uring)
+    {
+        /* After a failure the read waits, busy, for fallBack */
+        reader->states[b] = BUFFER_BUSY;
+        if(!reader->uringError && uringSubmit(reader, b))
+        {
+            reader->inflight++;
+        }
+        else
+        {
+            reader->uringError = 1;
+        }
+    }
+    else
+    {
+        pthread_mutex_lock(&reader->lock);
+        reader->inflight++;
+        reader->states[b] = BUFFER_QUEUED;
+        pthread_cond_broadcast(&reader->wake);
+        pthread_mutex_unlock(&reader->lock);
+    }
+}
+
+/* waitReady
+ *
+ * Waits until buffer b has been read, switching to threads if the
+ * ring fails first.
+ */
+
+static void waitReady(AsyncReader reader, int b)
+{
+    if(reader->uring)
+    {
+        while(!reader->uringError && reader->states[b] != BUFFER_READY)
+        {
+            uringReap(reader);
+        }
+
+        if(reader->states[b] != BUFFER_READY)
+        {
+            fallBack(reader);
+        }
+    }
+
+    if(!reader->uring)
+    {
+        pthread_mutex_lock(&reader->lock);
+        while(reader->states[b] != BUFFER_READY)
+        {
+            pthread_cond_wait(&reader->wake, &reader->lock);
+        }
+        pthread_mutex_unlock(&reader->lock);
+    }
+}
+
+/* drain
+ *
+ * Waits until no reads are in flight. A ring that can no longer be
+ * waited on has nothing more to give back.
+ */
+
+static void drain(AsyncReader reader)
+{
+    if(reader->uring)
+    {
+        while(reader->inflight > 0 && uringReap(reader))
+        {
+        }
+    }
+    else
+    {
+        pthread_mutex_lock(&reader->lock);
+
+        /* Take back queued reads no thread has started on */
+        while(reader->states[reader->claim] == BUFFER_QUEUED)
+        {
+            reader->states[reader->claim] = BUFFER_FREE;
+            reader->claim = (reader->claim + 1) % ASYNC_DEPTH;
+            reader->inflight--;
+        }
+
+        while(reader->inflight > 0)
+        {
+            pthread_cond_wait(&reader->wake, &reader->lock);
+        }
+        pthread_mutex_unlock(&reader->lock);
+    }
+}
+
+/********************************
+ *  6. AsyncReader Functions    *
+ ********************************/
+
+/* openAsyncReader
+ * ...
+ */
+
+AsyncReader openAsyncReader(const char* path)
+{
+    AsyncReader reader;
+    struct stat info;
+    void* buffer;
+    const char* mode;
+    int fd, direct, b;
+
+    if(strcmp(path, "-") == 0)
+    {
+        fd = dup(STDIN_FILENO);
+    }
+    else
+    {
+        fd = open(path, O_RDONLY);
+    }
+
+    if(fd < 0)
+    {
+        return NULL;
+    }
+
+    if(fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    /* Not every file system supports O_DIRECT; keep the plain
+       descriptor either way, for finishing short reads */
+    direct = -1;
+    if(S_ISREG(info.st_mode) && (long)info.st_size >= ASYNC_DIRECT_MIN)
+    {
+        direct = open(path, O_RDONLY | O_DIRECT);
+    }
+
+    reader = (AsyncReader)malloc(sizeof(struct AsyncReader_));
+    assert(reader != NULL);
+
+    if(direct >= 0)
+    {
+        reader->fd = direct;
+        reader->plainFd = fd;
+    }
+    else
+    {
+        reader->fd = fd;
+        reader->plainFd = -1;
+    }
+
+    reader->seekable = S_ISREG(info.st_mode);
+    reader->size = (long)info.st_size;
+    reader->head = 0;
+    reader->current = -1;
+    reader->claim = 0;
+    reader->nextOffset = 0;
+    reader->inflight = 0;
+    reader->failed = 0;
+    reader->uringError = 0;
+    reader->numThreads = 0;
+    reader->stop = 0;
+
+    /* Room for the '\0' after a full buffer without losing alignment */
+    for(b = 0; b < ASYNC_DEPTH; b++)
+    {
+        buffer = NULL;
+        if(posix_memalign(&buffer, ASYNC_ALIGN, ASYNC_BUFFER_SIZE + ASYNC_ALIGN) != 0)
+        {
+            buffer = NULL;
+        }
+        assert(buffer != NULL);
+
+        reader->buffers[b] = (char*)buffer;
+        reader->states[b] = BUFFER_FREE;
+        reader->lengths[b] = 0;
+        reader->offsets[b] = 0;
+    }
+
+    pthread_mutex_init(&reader->lock, NULL);
+    pthread_cond_init(&reader->wake, NULL);
+
+    mode = getenv(ASYNC_MODE_ENV);
+    reader->uring = reader->seekable && (mode == NULL || strcmp(mode, "threads") != 0) && uringSetup(reader);
+
+    if(!reader->uring)
+    {
+        startThreads(reader);
+    }
+
+    for(b = 0; b < ASYNC_DEPTH; b++)
+    {
+        queueRead(reader, b);
+    }
+
+    return reader;
+}
+
+/* closeAsyncReader
+ * ...
+ */
+
+void closeAsyncReader(AsyncReader reader)
+{
+    int b;
+
+    if(reader != NULL)
+    {
+        if(reader->uring)
+        {
+            drain(reader);
+            uringClose(reader);
+        }
+        else
+        {
+            pthread_mutex_lock(&reader->lock);
+            reader->stop = 1;
+            pthread_cond_broadcast(&reader->wake);
+            pthread_mutex_unlock(&reader->lock);
+
+            /* A thread waiting on a pipe would wait for the producer */
+            if(!reader->seekable)
+            {
+                pthread_cancel(reader->threads[0]);
+            }
+
+            for(b = 0; b < reader->numThreads; b++)
+            {
+                pthread_join(reader->threads[b], NULL);
+            }
+        }
+
+        pthread_mutex_destroy(&reader->lock);
+        pthread_cond_destroy(&reader->wake);
+
+        for(b = 0; b < ASYNC_DEPTH; b++)
+        {
+            free(reader->buffers[b]);
+        }
+
+        close(reader->fd);
+        if(reader->plainFd != -1)
+        {
+            close(reader->plainFd);
+        }
+        free(reader);
+    }
+}
+
+/* asyncReaderNext
+ * ...
+ */
+
+const char* asyncReaderNext(AsyncReader reader, long* length, long* offset)
+{
+    long n;
+    int b, fd;
+
+    if(reader->current != -1)
+    {
+        queueRead(reader, reader->current);
+        reader->current = -1;
+    }
+
+    b = reader->head;
+
+    if(reader->states[b] == BUFFER_FREE)
+    {
+        return NULL;
+    }
+
+    waitReady(reader, b);
+
+    /* A short read before the end of the file would leave a gap before
+       the next buffer, so finish it here. The rest starts at an
+       unaligned offset, which O_DIRECT refuses, so it is read through
+       the plain descriptor. If even that comes up short, the buffer is
+       failed rather than handed out with a gap after it. */
+    fd = (reader->plainFd != -1) ? reader->plainFd : reader->fd;
+    while(reader->seekable && reader->lengths[b] > 0 && reader->lengths[b] < ASYNC_BUFFER_SIZE &&
+          reader->offsets[b] + reader->lengths[b] < reader->size)
+    {
+        n = (long)pread(fd, reader->buffers[b] + reader->lengths[b],
+                        (size_t)(ASYNC_BUFFER_SIZE - reader->lengths[b]),
+                        (off_t)(reader->offsets[b] + reader->lengths[b]));
+        if(n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if(n <= 0)
+        {
+            reader->lengths[b] = -1;
+            break;
+        }
+        reader->lengths[b] += n;
+    }
+
+    if(reader->lengths[b] <= 0)
+    {
+        /* Leave the buffer ready so every later call ends here too */
+        if(reader->lengths[b] < 0 && !reader->failed)
+        {
+            fprintf(stderr, "Error: Could not read file.\n");
+            reader->failed = 1;
+        }
+        return NULL;
+    }
+
+    reader->buffers[b][reader->lengths[b]] = '\0';
+    reader->current = b;
+    reader->head = (b + 1) % ASYNC_DEPTH;
+
+    *length = reader->lengths[b];
+    *offset = reader->offsets[b];
+
+    return reader->buffers[b];
+}
+
+/* asyncReaderSeek
+ * ...
+ */
+
+long asyncReaderSeek(AsyncReader reader, long offset)
+{
+    long start;
+    int b;
+
+    if(!reader->seekable)
+    {
+        return -1;
+    }
+
+    drain(reader);
+
+    for(b = 0; b < ASYNC_DEPTH; b++)
+    {
+        reader->states[b] = BUFFER_FREE;
+    }
+
+    reader->head = 0;
+    reader->current = -1;
+    reader->claim = 0;
+    start = offset - (offset % ASYNC_ALIGN);
+    reader->nextOffset = start;
+
+    for(b = 0; b < ASYNC_DEPTH; b++)
+    {
+        queueRead(reader, b);
+    }
+
+    return start;
+}
+
+/* asyncReaderFailed
+ * ...
+ */
+
+int asyncReaderFailed(AsyncReader reader)
+{
+    return reader->failed;
+}
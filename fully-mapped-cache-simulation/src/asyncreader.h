@@ -0,0 +1,124 @@
+/* File: asyncreader.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Asynchronous file reader. Keeps ASYNC_DEPTH reads of ASYNC_BUFFER_SIZE
+ * bytes in flight and hands the buffers back in file order, so the
+ * caller parses one buffer while the next ones load. A handed out
+ * buffer belongs to the caller until the next call to asyncReaderNext,
+ * which queues it again for the next part of the file.
+ *
+ * Regular files are read through io_uring where the kernel supports it
+ * and with pread from ASYNC_THREADS background threads where it does
+ * not. If submitting to the ring or a read through it fails, the reader
+ * switches to the threads and rereads whatever it had not handed out,
+ * so only an error pread also hits is reported. Setting the environment
+ * variable ASYNC_MODE_ENV to "threads" skips io_uring altogether, to
+ * test or time the threads on a kernel that has it.
+ *
+ * Files of at least ASYNC_DIRECT_MIN bytes are opened with O_DIRECT so
+ * a trace that does not fit in the page cache does not evict everything
+ * else on its way through; buffers and offsets are aligned to
+ * ASYNC_ALIGN for this. Anything that cannot seek (standard
+ * input, given as "-", or a named pipe) is read in order by a single
+ * thread, and each buffer is handed out with whatever had arrived so
+ * the caller sees input as soon as it is written.
+ *
+ * The trace reader (trace.h) is built on this.
+ */
+
+#ifndef SWIFT_ASYNCREADER_H_
+#define SWIFT_ASYNCREADER_H_
+
+/* Bytes per read */
+#define ASYNC_BUFFER_SIZE (1 << 20)
+
+/* Reads kept in flight */
+#define ASYNC_DEPTH 4
+
+/* Buffer and offset alignment for O_DIRECT */
+#define ASYNC_ALIGN 4096
+
+/* Files at least this large bypass the page cache (1GB) */
+#define ASYNC_DIRECT_MIN (1L << 30)
+
+/* Bytes the first buffer from a pipe waits for, unless input ends */
+#define ASYNC_HEADER 8
+
+/* pread threads used when io_uring is unavailable */
+#define ASYNC_THREADS 2
+
+/* Environment variable that forces the threads when set to "threads" */
+#define ASYNC_MODE_ENV "SIM_READER"
+
+/* Typedefs */
+typedef struct AsyncReader_* AsyncReader;
+
+
+/* openAsyncReader
+ *
+ * Opens path and starts the first reads. Returns the new reader on
+ * success and NULL on failure.
+ *
+ * @param   path            file name, or "-" for standard input
+ *
+ * @return  success         new AsyncReader
+ * @return  failure         NULL
+ */
+
+AsyncReader openAsyncReader(const char* path);
+
+/* closeAsyncReader
+ *
+ * Waits for reads still in flight, closes the file and frees the
+ * reader. Passing NULL does nothing.
+ *
+ * @param   reader          reader to be closed
+ *
+ * @return  void
+ */
+
+void closeAsyncReader(AsyncReader reader);
+
+/* asyncReaderNext
+ *
+ * Returns the next buffer of the file, waiting for it if it is still
+ * loading, and gives the previous one back to be refilled. The buffer
+ * is followed by a '\0' that is not counted in length.
+ *
+ * @param   reader          target reader
+ * @param   length          set to the number of bytes in the buffer
+ * @param   offset          set to the file offset of the first byte
+ *
+ * @return  success         the buffer
+ * @return  end of file     NULL
+ */
+
+const char* asyncReaderNext(AsyncReader reader, long* length, long* offset);
+
+/* asyncReaderSeek
+ *
+ * Drops everything read ahead and restarts reading at offset, rounded
+ * down to ASYNC_ALIGN. The next buffer starts at the returned offset.
+ *
+ * @param   reader          target reader
+ * @param   offset          file offset wanted
+ *
+ * @return  success         offset the next buffer starts at
+ * @return  failure         -1 (the file cannot seek)
+ */
+
+long asyncReaderSeek(AsyncReader reader, long offset);
+
+/* asyncReaderFailed
+ *
+ * @param   reader          target reader
+ *
+ * @return  int             1 if a read failed, 0 otherwise
+ */
+
+int asyncReaderFailed(AsyncReader reader);
+
+
+#endif
+/* SWIFT_ASYNCREADER_H_ */
@@ -0,0 +1,209 @@
+/* File: bloom.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Blocked counting Bloom filter. See bloom.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -BloomFilter
+ *      3. Utility Functions
+ *          -hashTag
+ *      4. BloomFilter Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "bloom.h"
+
+/* Counters per block, one cache line */
+#define BLOOM_BLOCK 64
+
+/* Largest counter value, which is never decremented */
+#define BLOOM_SATURATED 255
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* BloomFilter
+ *
+ * @param   mask            number of blocks - 1 (a power of two)
+ * @param   counters        BLOOM_BLOCK counters per block
+ * @param   stats           lookup counters
+ */
+
+struct BloomFilter_ {
+    unsigned long mask;
+    unsigned char* counters;
+    BloomStats stats;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* hashTag
+ *
+ * Mixes tag so that its high half picks the block and its low 24 bits
+ * the BLOOM_HASHES counters within it, six bits each. Unrelated to the
+ * tag index hashes, so filter and index collisions do not line up.
+ */
+
+static unsigned long hashTag(unsigned long tag)
+{
+    tag *= 0xC2B2AE3D27D4EB4FUL;
+    tag ^= tag >> 29;
+    tag *= 0x165667B19E3779F9UL;
+    tag ^= tag >> 32;
+
+    return tag;
+}
+
+/********************************
+ *  4. BloomFilter Functions    *
+ ********************************/
+
+/* createBloomFilter
+ * ...
+ */
+
+BloomFilter createBloomFilter(int entries, int counters)
+{
+    BloomFilter filter;
+    unsigned long blocks;
+
+    if(entries <= 0 || counters <= 0 || counters > 1024)
+    {
+        fprintf(stderr, "Invalid Bloom filter size.\n");
+        return NULL;
+    }
+
+    blocks = 1;
+    while(blocks * BLOOM_BLOCK < (unsigned long)entries * (unsigned long)counters)
+    {
+        blocks = blocks * 2;
+    }
+
+    filter = (BloomFilter)malloc(sizeof(struct BloomFilter_));
+    assert(filter != NULL);
+
+    filter->mask = blocks - 1;
+    filter->counters = (unsigned char*)calloc(blocks, BLOOM_BLOCK);
+    assert(filter->counters != NULL);
+
+    filter->stats.lookups = 0;
+    filter->stats.rejected = 0;
+    filter->stats.falsePositives = 0;
+
+    return filter;
+}
+
+/* destroyBloomFilter
+ * ...
+ */
+
+void destroyBloomFilter(BloomFilter filter)
+{
+    if(filter != NULL)
+    {
+        free(filter->counters);
+        free(filter);
+    }
+}
+
+/* bloomAdd
+ * ...
+ */
+
+void bloomAdd(BloomFilter filter, unsigned long tag)
+{
+    unsigned long hash;
+    unsigned char* block;
+    int i;
+
+    hash = hashTag(tag);
+    block = filter->counters + ((hash >> 32) & filter->mask) * BLOOM_BLOCK;
+
+    for(i = 0; i < BLOOM_HASHES; i++, hash >>= 6)
+    {
+        if(block[hash & (BLOOM_BLOCK - 1)] < BLOOM_SATURATED)
+        {
+            block[hash & (BLOOM_BLOCK - 1)]++;
+        }
+    }
+}
+
+/* bloomRemove
+ * ...
+ */
+
+void bloomRemove(BloomFilter filter, unsigned long tag)
+{
+    unsigned long hash;
+    unsigned char* block;
+    int i;
+
+    hash = hashTag(tag);
+    block = filter->counters + ((hash >> 32) & filter->mask) * BLOOM_BLOCK;
+
+    for(i = 0; i < BLOOM_HASHES; i++, hash >>= 6)
+    {
+        /* A saturated counter may be shared by tags still held */
+        if(block[hash & (BLOOM_BLOCK - 1)] < BLOOM_SATURATED)
+        {
+            assert(block[hash & (BLOOM_BLOCK - 1)] > 0);
+            block[hash & (BLOOM_BLOCK - 1)]--;
+        }
+    }
+}
+
+/* bloomCheck
+ * ...
+ */
+
+int bloomCheck(BloomFilter filter, unsigned long tag)
+{
+    unsigned long hash;
+    const unsigned char* block;
+    int i, held;
+
+    hash = hashTag(tag);
+    block = filter->counters + ((hash >> 32) & filter->mask) * BLOOM_BLOCK;
+
+    /* No early exit: all the counters are in one line anyway */
+    held = 1;
+    for(i = 0; i < BLOOM_HASHES; i++, hash >>= 6)
+    {
+        held &= (block[hash & (BLOOM_BLOCK - 1)] != 0);
+    }
+
+    filter->stats.lookups++;
+    filter->stats.rejected += !held;
+
+    return held;
+}
+
+/* bloomFalsePositive
+ * ...
+ */
+
+void bloomFalsePositive(BloomFilter filter)
+{
+    filter->stats.falsePositives++;
+}
+
+/* bloomGetStats
+ * ...
+ */
+
+void bloomGetStats(BloomFilter filter, BloomStats* stats)
+{
+    *stats = filter->stats;
+}
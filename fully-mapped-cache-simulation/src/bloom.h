@@ -0,0 +1,134 @@
+/* File: bloom.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Counting Bloom filter over the tags resident in a cache. A lookup that
+ * the filter rejects is a certain miss and needs no tag index probe;
+ * one it accepts may still miss, which is a false positive. Counters
+ * rather than bits let an evicted tag be taken out again.
+ *
+ * The filter is blocked: a tag's BLOOM_HASHES counters all sit in one
+ * 64 byte block of one byte counters, so a check reads a single cache
+ * line. At the default eight counters per tag the filter is a quarter
+ * the size of the tag index, which keeps it in a nearer cache level for
+ * large simulated caches. A counter that reaches 255 stays there, so
+ * the filter never forgets a resident tag.
+ */
+
+#ifndef SWIFT_BLOOM_H_
+#define SWIFT_BLOOM_H_
+
+/* Counters set per tag */
+#define BLOOM_HASHES 4
+
+/* Default counters per tag held */
+#define BLOOM_COUNTERS 8
+
+/* Typedefs */
+typedef struct BloomFilter_* BloomFilter;
+
+/* BloomStats
+ *
+ * Counters kept by a BloomFilter.
+ *
+ * @param   lookups         checks made
+ * @param   rejected        checks that ruled the tag out
+ * @param   falsePositives  accepted tags that were not held
+ */
+
+typedef struct BloomStats_ {
+    unsigned long lookups;
+    unsigned long rejected;
+    unsigned long falsePositives;
+} BloomStats;
+
+
+/* createBloomFilter
+ *
+ * Function to create an empty filter for up to entries tags. Returns the
+ * new filter on success and NULL on failure.
+ *
+ * @param   entries         maximum number of tags held at once
+ * @param   counters        counters per tag, rounded up so the total is
+ *                          a power of two
+ *
+ * @return  success         new BloomFilter
+ * @return  failure         NULL
+ */
+
+BloomFilter createBloomFilter(int entries, int counters);
+
+/* destroyBloomFilter
+ *
+ * Frees all memory held by the filter. Passing NULL does nothing.
+ *
+ * @param   filter          filter to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyBloomFilter(BloomFilter filter);
+
+/* bloomAdd
+ *
+ * Adds tag to the filter.
+ *
+ * @param   filter          target filter
+ * @param   tag             block tag
+ *
+ * @return  void
+ */
+
+void bloomAdd(BloomFilter filter, unsigned long tag);
+
+/* bloomRemove
+ *
+ * Takes out a tag added earlier.
+ *
+ * @param   filter          target filter
+ * @param   tag             block tag
+ *
+ * @return  void
+ */
+
+void bloomRemove(BloomFilter filter, unsigned long tag);
+
+/* bloomCheck
+ *
+ * Checks whether tag may be held, counting the lookup.
+ *
+ * @param   filter          target filter
+ * @param   tag             block tag
+ *
+ * @return  maybe held      1
+ * @return  not held        0
+ */
+
+int bloomCheck(BloomFilter filter, unsigned long tag);
+
+/* bloomFalsePositive
+ *
+ * Counts an accepted tag that turned out not to be held.
+ *
+ * @param   filter          target filter
+ *
+ * @return  void
+ */
+
+void bloomFalsePositive(BloomFilter filter);
+
+/* bloomGetStats
+ *
+ * Copies out the counters.
+ *
+ * @param   filter          target filter
+ * @param   stats           filled with the counters
+ *
+ * @return  void
+ */
+
+void bloomGetStats(BloomFilter filter, BloomStats* stats);
+
+
+#endif
+/* SWIFT_BLOOM_H_ */
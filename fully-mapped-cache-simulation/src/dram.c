@@ -0,0 +1,257 @@
+/* File: dram.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * DRAM model. See dram.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -Bank
+ *          -Dram
+ *      3. Utility Functions
+ *          -log2Exact
+ *      4. Dram Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "dram.h"
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* Bank
+ *
+ * @param   open            1 if a row is in the row buffer
+ * @param   row             the open row
+ * @param   ready           cycle the bank can take the next request
+ */
+
+typedef struct Bank_ {
+    int open;
+    unsigned long row;
+    unsigned long ready;
+} Bank;
+
+/* Dram
+ *
+ * @param   channelBits     log2 of the number of channels
+ * @param   bankBits        log2 of the banks per channel
+ * @param   rowBits         log2 of the row size
+ * @param   pagePolicy      DRAM_OPEN_PAGE or DRAM_CLOSED_PAGE
+ * @param   banks           every bank, channel by channel
+ * @param   busReady        cycle each channel's data bus is free
+ * @param   stats           counters
+ */
+
+struct Dram_ {
+    int channelBits;
+    int bankBits;
+    int rowBits;
+    int pagePolicy;
+    Bank* banks;
+    unsigned long* busReady;
+    DramStats stats;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* log2Exact
+ *
+ * Returns log2(value) for a power of two, and -1 for anything else.
+ */
+
+static int log2Exact(long value)
+{
+    int bits;
+
+    if(value <= 0 || (value & (value - 1)) != 0)
+    {
+        return -1;
+    }
+
+    bits = 0;
+    while((1L << bits) < value)
+    {
+        bits++;
+    }
+
+    return bits;
+}
+
+/********************************
+ *      4. Dram Functions       *
+ ********************************/
+
+/* createDram
+ * ...
+ */
+
+Dram createDram(int channels, int banks, long row_size, int page_policy)
+{
+    Dram dram;
+    int channelBits, bankBits, rowBits;
+
+    channelBits = log2Exact(channels);
+    bankBits = log2Exact(banks);
+    rowBits = log2Exact(row_size);
+
+    if(channelBits < 0 || bankBits < 0 || rowBits < 0 || row_size < DRAM_BURST ||
+       channelBits + bankBits + rowBits >= (int)(sizeof(unsigned long) * 8) ||
+       (page_policy != DRAM_OPEN_PAGE && page_policy != DRAM_CLOSED_PAGE))
+    {
+        fprintf(stderr, "Invalid DRAM parameters.\n");
+        return NULL;
+    }
+
+    dram = (Dram)malloc(sizeof(struct Dram_));
+    assert(dram != NULL);
+
+    dram->channelBits = channelBits;
+    dram->bankBits = bankBits;
+    dram->rowBits = rowBits;
+    dram->pagePolicy = page_policy;
+
+    dram->banks = (Bank*)calloc((size_t)channels * (size_t)banks, sizeof(Bank));
+    assert(dram->banks != NULL);
+
+    dram->busReady = (unsigned long*)calloc((size_t)channels, sizeof(unsigned long));
+    assert(dram->busReady != NULL);
+
+    memset(&dram->stats, 0, sizeof(DramStats));
+
+    return dram;
+}
+
+/* destroyDram
+ * ...
+ */
+
+void destroyDram(Dram dram)
+{
+    if(dram != NULL)
+    {
+        free(dram->banks);
+        free(dram->busReady);
+        free(dram);
+    }
+}
+
+/* dramAccess
+ * ...
+ */
+
+unsigned long dramAccess(Dram dram, unsigned long address, unsigned long bytes, int write, unsigned long now)
+{
+    Bank* bank;
+    unsigned long channel, row, start, column, ready, transfer;
+
+    /* Bit slices: | row | bank | channel | column | */
+    channel = (address >> dram->rowBits) & ((1UL << dram->channelBits) - 1);
+    bank = &dram->banks[(channel << dram->bankBits) |
+                        ((address >> (dram->rowBits + dram->channelBits)) & ((1UL << dram->bankBits) - 1))];
+    row = address >> (dram->rowBits + dram->channelBits + dram->bankBits);
+
+    if(dram->stats.reads + dram->stats.writes == 0)
+    {
+        dram->stats.first = now;
+    }
+
+    if(write)
+    {
+        dram->stats.writes++;
+    }
+    else
+    {
+        dram->stats.reads++;
+    }
+
+    start = now;
+    if(bank->ready > now)
+    {
+        dram->stats.bankWaitCycles += bank->ready - now;
+        start = bank->ready;
+    }
+
+    /* Row buffer: column is when the column command can go out */
+    if(bank->open && bank->row == row)
+    {
+        dram->stats.rowHits++;
+        column = start;
+    }
+    else if(bank->open)
+    {
+        dram->stats.rowConflicts++;
+        column = start + DRAM_T_RP + DRAM_T_RCD;
+    }
+    else
+    {
+        dram->stats.rowMisses++;
+        column = start + DRAM_T_RCD;
+    }
+    ready = column + DRAM_T_CAS;
+
+    /* Data bus */
+    transfer = DRAM_T_BURST * ((bytes + DRAM_BURST - 1) / DRAM_BURST);
+    if(transfer == 0)
+    {
+        transfer = DRAM_T_BURST;
+    }
+
+    if(dram->busReady[channel] > ready)
+    {
+        ready = dram->busReady[channel];
+    }
+    dram->busReady[channel] = ready + transfer;
+
+    dram->stats.bytes += bytes;
+    dram->stats.busCycles += transfer;
+    if(ready + transfer > dram->stats.last)
+    {
+        dram->stats.last = ready + transfer;
+    }
+
+    if(dram->pagePolicy == DRAM_OPEN_PAGE)
+    {
+        /* Column commands to an open row pipeline, one per burst */
+        bank->open = 1;
+        bank->row = row;
+        bank->ready = column + transfer;
+    }
+    else
+    {
+        /* Auto precharge once the column command is done */
+        bank->open = 0;
+        bank->ready = column + transfer + DRAM_T_RP;
+    }
+
+    return ready + transfer - now;
+}
+
+/* dramGetStats
+ * ...
+ */
+
+void dramGetStats(Dram dram, DramStats* stats)
+{
+    *stats = dram->stats;
+}
+
+/* dramChannels
+ * ...
+ */
+
+int dramChannels(Dram dram)
+{
+    return 1 << dram->channelBits;
+}
@@ -0,0 +1,155 @@
+/* File: dram.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * DRAM model for the memory behind the cache. Memory is split into
+ * channels, each with its own data bus, and each channel into banks.
+ * A bank holds at most one open row in its row buffer:
+ *
+ *      row hit         the row is open: column access only (tCAS)
+ *      row miss        the bank is precharged: activate, then column
+ *                      access (tRCD + tCAS)
+ *      row conflict    another row is open: precharge first
+ *                      (tRP + tRCD + tCAS). These are the bank
+ *                      conflicts.
+ *
+ * Under the open page policy a row stays open after an access; under
+ * the closed page policy the bank precharges straight away, so every
+ * access is a row miss but none pays for a precharge.
+ *
+ * Every transfer then takes the channel's data bus for DRAM_T_BURST
+ * cycles per DRAM_BURST bytes. A bank or bus that is still busy makes a
+ * request wait. All timings are in core cycles.
+ *
+ * Addresses are mapped by bit slices, from the low bits up:
+ *
+ *      | row | bank | channel | column (log2 row size) |
+ *
+ * so a whole row is contiguous and consecutive rows go round the
+ * channels, then the banks. Finding the bank is two shifts and two
+ * masks, since every size is a power of two.
+ */
+
+#ifndef SWIFT_DRAM_H_
+#define SWIFT_DRAM_H_
+
+/* Geometry Defaults */
+#define DRAM_CHANNELS 1
+#define DRAM_BANKS 8
+#define DRAM_ROW_SIZE 8192
+
+/* Bytes per burst */
+#define DRAM_BURST 64
+
+/* Timings (core cycles; about DDR4-3200 behind a 3GHz core) */
+#define DRAM_T_CAS 42
+#define DRAM_T_RCD 42
+#define DRAM_T_RP 42
+#define DRAM_T_BURST 8
+
+/* Page Policies */
+#define DRAM_OPEN_PAGE 0
+#define DRAM_CLOSED_PAGE 1
+
+/* Typedefs */
+typedef struct Dram_* Dram;
+
+/* DramStats
+ *
+ * Counters kept by a Dram.
+ *
+ * @param   reads           read requests
+ * @param   writes          write requests
+ * @param   rowHits         requests that found their row open
+ * @param   rowMisses       requests to a precharged bank
+ * @param   rowConflicts    requests that found another row open
+ * @param   bankWaitCycles  cycles requests waited for a busy bank
+ * @param   bytes           bytes transferred
+ * @param   busCycles       cycles the data buses were transferring,
+ *                          summed over the channels
+ * @param   first           cycle of the first request
+ * @param   last            cycle the last transfer ended
+ */
+
+typedef struct DramStats_ {
+    unsigned long reads;
+    unsigned long writes;
+    unsigned long rowHits;
+    unsigned long rowMisses;
+    unsigned long rowConflicts;
+    unsigned long bankWaitCycles;
+    unsigned long bytes;
+    unsigned long busCycles;
+    unsigned long first;
+    unsigned long last;
+} DramStats;
+
+
+/* createDram
+ *
+ * Function to create a DRAM with every bank precharged. Returns the new
+ * DRAM on success and NULL on failure.
+ *
+ * @param   channels        number of channels (a power of two)
+ * @param   banks           banks per channel (a power of two)
+ * @param   row_size        bytes per row (a power of two)
+ * @param   page_policy     DRAM_OPEN_PAGE or DRAM_CLOSED_PAGE
+ *
+ * @return  success         new Dram
+ * @return  failure         NULL
+ */
+
+Dram createDram(int channels, int banks, long row_size, int page_policy);
+
+/* destroyDram
+ *
+ * Frees all memory held by the DRAM. Passing NULL does nothing.
+ *
+ * @param   dram            DRAM to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyDram(Dram dram);
+
+/* dramAccess
+ *
+ * Simulates a request for bytes bytes at address arriving at cycle now.
+ * Returns the cycles until its data has been transferred, including any
+ * wait for a busy bank or bus.
+ *
+ * @param   dram            target DRAM
+ * @param   address         byte address
+ * @param   bytes           bytes transferred
+ * @param   write           0 = read, 1 = write
+ * @param   now             cycle the request arrives
+ *
+ * @return  unsigned long   latency in cycles
+ */
+
+unsigned long dramAccess(Dram dram, unsigned long address, unsigned long bytes, int write, unsigned long now);
+
+/* dramGetStats
+ *
+ * Copies out the counters.
+ *
+ * @param   dram            target DRAM
+ * @param   stats           filled with the counters
+ *
+ * @return  void
+ */
+
+void dramGetStats(Dram dram, DramStats* stats);
+
+/* dramChannels
+ *
+ * @param   dram            target DRAM
+ *
+ * @return  int             number of channels
+ */
+
+int dramChannels(Dram dram);
+
+
+#endif
+/* SWIFT_DRAM_H_ */
@@ -0,0 +1,382 @@
+/* File: freqlist.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Constant time frequency list. See freqlist.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -FreqList
+ *      3. Bucket Helpers
+ *          -newBucket
+ *          -freeBucket
+ *          -linkItem
+ *          -unlinkItem
+ *      4. FreqList Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "freqlist.h"
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* FreqList
+ *
+ * Items and buckets both live in flat arrays and are linked by index,
+ * so nothing is allocated after the list is created. A list of n items
+ * never needs more than n + 1 buckets (n in use plus one being moved
+ * into), and unused buckets are chained through bucketNext.
+ *
+ * @param   capacity        number of items
+ * @param   itemBucket      bucket holding each item (-1 = not in list)
+ * @param   itemPrev        previous item in the same bucket
+ * @param   itemNext        next item in the same bucket
+ * @param   bucketCount     count shared by every item in the bucket
+ * @param   bucketHead      most recently counted item in the bucket
+ * @param   bucketTail      least recently counted item in the bucket
+ * @param   bucketPrev      bucket with the next smaller count
+ * @param   bucketNext      bucket with the next larger count
+ * @param   first           bucket with the smallest count
+ * @param   freeBuckets     head of the unused bucket chain
+ */
+
+struct FreqList_ {
+    int capacity;
+    int* itemBucket;
+    int* itemPrev;
+    int* itemNext;
+    unsigned long* bucketCount;
+    int* bucketHead;
+    int* bucketTail;
+    int* bucketPrev;
+    int* bucketNext;
+    int first;
+    int freeBuckets;
+};
+
+/********************************
+ *      3. Bucket Helpers       *
+ ********************************/
+
+/* newBucket
+ *
+ * Takes a bucket off the free chain and links it in after prev (or at
+ * the front of the list if prev is -1).
+ */
+
+static int newBucket(FreqList list, int prev, unsigned long count)
+{
+    int b, next;
+
+    b = list->freeBuckets;
+    assert(b != -1);
+    list->freeBuckets = list->bucketNext[b];
+
+    next = (prev == -1) ? list->first : list->bucketNext[prev];
+
+    list->bucketCount[b] = count;
+    list->bucketHead[b] = -1;
+    list->bucketTail[b] = -1;
+    list->bucketPrev[b] = prev;
+    list->bucketNext[b] = next;
+
+    if(prev == -1)
+    {
+        list->first = b;
+    }
+    else
+    {
+        list->bucketNext[prev] = b;
+    }
+
+    if(next != -1)
+    {
+        list->bucketPrev[next] = b;
+    }
+
+    return b;
+}
+
+/* freeBucket
+ *
+ * Unlinks an empty bucket and returns it to the free chain.
+ */
+
+static void freeBucket(FreqList list, int b)
+{
+    int prev, next;
+
+    prev = list->bucketPrev[b];
+    next = list->bucketNext[b];
+
+    if(prev == -1)
+    {
+        list->first = next;
+    }
+    else
+    {
+        list->bucketNext[prev] = next;
+    }
+
+    if(next != -1)
+    {
+        list->bucketPrev[next] = prev;
+    }
+
+    list->bucketNext[b] = list->freeBuckets;
+    list->freeBuckets = b;
+}
+
+/* linkItem
+ *
+ * Puts an item at the head of a bucket.
+ */
+
+static void linkItem(FreqList list, int b, int item)
+{
+    int head;
+
+    head = list->bucketHead[b];
+
+    list->itemBucket[item] = b;
+    list->itemPrev[item] = -1;
+    list->itemNext[item] = head;
+
+    if(head == -1)
+    {
+        list->bucketTail[b] = item;
+    }
+    else
+    {
+        list->itemPrev[head] = item;
+    }
+
+    list->bucketHead[b] = item;
+}
+
+/* unlinkItem
+ *
+ * Takes an item out of its bucket. The bucket is left in place even if
+ * it becomes empty; the caller decides whether to free it.
+ */
+
+static void unlinkItem(FreqList list, int item)
+{
+    int b, prev, next;
+
+    b = list->itemBucket[item];
+    prev = list->itemPrev[item];
+    next = list->itemNext[item];
+
+    if(prev == -1)
+    {
+        list->bucketHead[b] = next;
+    }
+    else
+    {
+        list->itemNext[prev] = next;
+    }
+
+    if(next == -1)
+    {
+        list->bucketTail[b] = prev;
+    }
+    else
+    {
+        list->itemPrev[next] = prev;
+    }
+
+    list->itemBucket[item] = -1;
+}
+
+/********************************
+ *    4. FreqList Functions     *
+ ********************************/
+
+/* createFreqList
+ * ...
+ */
+
+FreqList createFreqList(int capacity)
+{
+    FreqList list;
+    int i;
+
+    if(capacity <= 0)
+    {
+        fprintf(stderr, "Invalid frequency list capacity.\n");
+        return NULL;
+    }
+
+    list = (FreqList)malloc(sizeof(struct FreqList_));
+    assert(list != NULL);
+
+    list->capacity = capacity;
+
+    list->itemBucket = (int*)malloc(sizeof(int) * capacity);
+    list->itemPrev = (int*)malloc(sizeof(int) * capacity);
+    list->itemNext = (int*)malloc(sizeof(int) * capacity);
+    assert(list->itemBucket != NULL && list->itemPrev != NULL && list->itemNext != NULL);
+
+    list->bucketCount = (unsigned long*)malloc(sizeof(unsigned long) * (capacity + 1));
+    list->bucketHead = (int*)malloc(sizeof(int) * (capacity + 1));
+    list->bucketTail = (int*)malloc(sizeof(int) * (capacity + 1));
+    list->bucketPrev = (int*)malloc(sizeof(int) * (capacity + 1));
+    list->bucketNext = (int*)malloc(sizeof(int) * (capacity + 1));
+    assert(list->bucketCount != NULL && list->bucketHead != NULL && list->bucketTail != NULL);
+    assert(list->bucketPrev != NULL && list->bucketNext != NULL);
+
+    for(i = 0; i < capacity; i++)
+    {
+        list->itemBucket[i] = -1;
+    }
+
+    /* Chain every bucket onto the free list */
+    for(i = 0; i <= capacity; i++)
+    {
+        list->bucketNext[i] = (i == capacity) ? -1 : i + 1;
+    }
+
+    list->first = -1;
+    list->freeBuckets = 0;
+
+    return list;
+}
+
+/* destroyFreqList
+ * ...
+ */
+
+void destroyFreqList(FreqList list)
+{
+    if(list != NULL)
+    {
+        free(list->itemBucket);
+        free(list->itemPrev);
+        free(list->itemNext);
+        free(list->bucketCount);
+        free(list->bucketHead);
+        free(list->bucketTail);
+        free(list->bucketPrev);
+        free(list->bucketNext);
+        free(list);
+    }
+}
+
+/* freqListInsert
+ * ...
+ */
+
+void freqListInsert(FreqList list, int item, unsigned long count)
+{
+    int b, prev;
+
+    /* Find the last bucket with a count no larger than the new one */
+    prev = -1;
+    b = list->first;
+
+    while(b != -1 && list->bucketCount[b] <= count)
+    {
+        prev = b;
+        b = list->bucketNext[b];
+    }
+
+    if(prev == -1 || list->bucketCount[prev] != count)
+    {
+        prev = newBucket(list, prev, count);
+    }
+
+    linkItem(list, prev, item);
+}
+
+/* freqListAdd
+ * ...
+ */
+
+void freqListAdd(FreqList list, int item, unsigned long n)
+{
+    int b, prev, next;
+    unsigned long count;
+
+    b = list->itemBucket[item];
+    count = list->bucketCount[b] + n;
+
+    /* Walk forward to the last bucket with a count no larger than the
+       new one. For n = 1 this stops immediately. */
+    prev = b;
+    next = list->bucketNext[b];
+
+    while(next != -1 && list->bucketCount[next] <= count)
+    {
+        prev = next;
+        next = list->bucketNext[next];
+    }
+
+    unlinkItem(list, item);
+
+    if(list->bucketCount[prev] != count)
+    {
+        prev = newBucket(list, prev, count);
+    }
+
+    linkItem(list, prev, item);
+
+    if(list->bucketHead[b] == -1)
+    {
+        freeBucket(list, b);
+    }
+}
+
+/* freqListRemove
+ * ...
+ */
+
+void freqListRemove(FreqList list, int item)
+{
+    int b;
+
+    b = list->itemBucket[item];
+
+    if(b == -1)
+    {
+        return;
+    }
+
+    unlinkItem(list, item);
+
+    if(list->bucketHead[b] == -1)
+    {
+        freeBucket(list, b);
+    }
+}
+
+/* freqListMin
+ * ...
+ */
+
+int freqListMin(FreqList list)
+{
+    return (list->first == -1) ? -1 : list->bucketTail[list->first];
+}
+
+/* freqListCount
+ * ...
+ */
+
+unsigned long freqListCount(FreqList list, int item)
+{
+    int b;
+
+    b = list->itemBucket[item];
+
+    return (b == -1) ? 0 : list->bucketCount[b];
+}
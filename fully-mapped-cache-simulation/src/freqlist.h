@@ -0,0 +1,115 @@
+/* File: freqlist.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * A frequency list keeps a count for each of a fixed number of items
+ * (numbered 0 to capacity - 1) and can hand back the item with the
+ * smallest count in constant time. Items with the same count share a
+ * bucket, and the buckets are kept in a list ordered by count, so
+ * incrementing an item only ever moves it into the neighbouring bucket.
+ *
+ * Within a bucket items are kept most recently counted first, so ties
+ * on the minimum count are broken in least recently used order.
+ */
+
+#ifndef SWIFT_FREQLIST_H_
+#define SWIFT_FREQLIST_H_
+
+/* Typedefs */
+typedef struct FreqList_* FreqList;
+
+
+/* createFreqList
+ *
+ * Function to create an empty frequency list that can hold the items
+ * 0 to capacity - 1. Returns the new list on success and NULL on failure.
+ *
+ * @param   capacity        number of items the list can hold
+ *
+ * @return  success         new FreqList
+ * @return  failure         NULL
+ */
+
+FreqList createFreqList(int capacity);
+
+/* destroyFreqList
+ *
+ * Frees all memory held by the list. Passing NULL does nothing.
+ *
+ * @param   list            list to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyFreqList(FreqList list);
+
+/* freqListInsert
+ *
+ * Adds an item that is not currently in the list with the given count.
+ * Inserting with a count of 1 is constant time; larger counts walk the
+ * bucket list from the front.
+ *
+ * @param   list            target list
+ * @param   item            item number
+ * @param   count           starting count (at least 1)
+ *
+ * @return  void
+ */
+
+void freqListInsert(FreqList list, int item, unsigned long count);
+
+/* freqListAdd
+ *
+ * Adds n to the count of an item that is in the list. Adding 1 is
+ * constant time.
+ *
+ * @param   list            target list
+ * @param   item            item number
+ * @param   n               amount to add
+ *
+ * @return  void
+ */
+
+void freqListAdd(FreqList list, int item, unsigned long n);
+
+/* freqListRemove
+ *
+ * Removes an item from the list. Removing an item that is not in the
+ * list does nothing.
+ *
+ * @param   list            target list
+ * @param   item            item number
+ *
+ * @return  void
+ */
+
+void freqListRemove(FreqList list, int item);
+
+/* freqListMin
+ *
+ * Returns the least recently counted item among those with the
+ * smallest count, or -1 if the list is empty.
+ *
+ * @param   list            target list
+ *
+ * @return  success         item number
+ * @return  empty           -1
+ */
+
+int freqListMin(FreqList list);
+
+/* freqListCount
+ *
+ * Returns the count of an item, or 0 if it is not in the list.
+ *
+ * @param   list            target list
+ * @param   item            item number
+ *
+ * @return  unsigned long   count
+ */
+
+unsigned long freqListCount(FreqList list, int item);
+
+
+#endif
+/* SWIFT_FREQLIST_H_ */
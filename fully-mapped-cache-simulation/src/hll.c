@@ -0,0 +1,169 @@
+/* File: hll.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * HyperLogLog cardinality estimator. See hll.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -Hll
+ *      3. Utility Functions
+ *          -mixKey
+ *      4. Hll Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include "hll.h"
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* Hll
+ *
+ * @param   precision       log2 of the number of registers
+ * @param   registers       largest leading zero run + 1 seen per register
+ */
+
+struct Hll_ {
+    int precision;
+    unsigned char* registers;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* mixKey
+ *
+ * 64 bit finalizer. HyperLogLog needs every hash bit to be close to
+ * uniform, which raw addresses are not.
+ */
+
+static uint64_t mixKey(unsigned long key)
+{
+    uint64_t h;
+
+    h = (uint64_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdUL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53UL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+/********************************
+ *       4. Hll Functions       *
+ ********************************/
+
+/* createHll
+ * ...
+ */
+
+Hll createHll(int precision)
+{
+    Hll hll;
+
+    if(precision < 4 || precision > 18)
+    {
+        fprintf(stderr, "Invalid HyperLogLog precision.\n");
+        return NULL;
+    }
+
+    hll = (Hll)malloc(sizeof(struct Hll_));
+    assert(hll != NULL);
+
+    hll->precision = precision;
+    hll->registers = (unsigned char*)calloc((size_t)1 << precision, 1);
+    assert(hll->registers != NULL);
+
+    return hll;
+}
+
+/* destroyHll
+ * ...
+ */
+
+void destroyHll(Hll hll)
+{
+    if(hll != NULL)
+    {
+        free(hll->registers);
+        free(hll);
+    }
+}
+
+/* hllAdd
+ * ...
+ */
+
+void hllAdd(Hll hll, unsigned long key)
+{
+    uint64_t h, rest;
+    unsigned char rank;
+
+    h = mixKey(key);
+
+    /* The top precision bits pick the register; the rank is the position
+       of the first set bit in what is left */
+    rest = (h << hll->precision) | ((uint64_t)1 << (hll->precision - 1));
+    rank = 1;
+
+    while((rest & ((uint64_t)1 << 63)) == 0)
+    {
+        rank++;
+        rest = rest << 1;
+    }
+
+    if(rank > hll->registers[h >> (64 - hll->precision)])
+    {
+        hll->registers[h >> (64 - hll->precision)] = rank;
+    }
+}
+
+/* hllEstimate
+ * ...
+ */
+
+unsigned long hllEstimate(Hll hll)
+{
+    unsigned long m, i, zeros;
+    double sum, alpha, estimate;
+
+    m = 1UL << hll->precision;
+    sum = 0.0;
+    zeros = 0;
+
+    for(i = 0; i < m; i++)
+    {
+        sum += ldexp(1.0, -(int)hll->registers[i]);
+
+        if(hll->registers[i] == 0)
+        {
+            zeros++;
+        }
+    }
+
+    alpha = 0.7213 / (1.0 + 1.079 / (double)m);
+    estimate = alpha * (double)m * (double)m / sum;
+
+    /* Small range correction: linear counting is more accurate while
+       some registers are still empty */
+    if(estimate <= 2.5 * (double)m && zeros != 0)
+    {
+        estimate = (double)m * log((double)m / (double)zeros);
+    }
+
+    return (unsigned long)(estimate + 0.5);
+}
@@ -0,0 +1,67 @@
+/* File: hll.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * HyperLogLog cardinality estimator. Counts the distinct keys in a
+ * stream using 2^precision one byte registers, with a standard error of
+ * about 1.04 / sqrt(2^precision). At precision 14 that is 16KB of state
+ * and under 1% error no matter how many keys are added.
+ */
+
+#ifndef SWIFT_HLL_H_
+#define SWIFT_HLL_H_
+
+/* Typedefs */
+typedef struct Hll_* Hll;
+
+
+/* createHll
+ *
+ * Function to create an empty estimator. Returns the new estimator on
+ * success and NULL on failure.
+ *
+ * @param   precision       log2 of the number of registers (4 to 18)
+ *
+ * @return  success         new Hll
+ * @return  failure         NULL
+ */
+
+Hll createHll(int precision);
+
+/* destroyHll
+ *
+ * Frees all memory held by the estimator. Passing NULL does nothing.
+ *
+ * @param   hll             estimator to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyHll(Hll hll);
+
+/* hllAdd
+ *
+ * Adds a key to the estimator.
+ *
+ * @param   hll             target estimator
+ * @param   key             key to add
+ *
+ * @return  void
+ */
+
+void hllAdd(Hll hll, unsigned long key);
+
+/* hllEstimate
+ *
+ * Returns the estimated number of distinct keys added so far.
+ *
+ * @param   hll             target estimator
+ *
+ * @return  unsigned long   estimated cardinality
+ */
+
+unsigned long hllEstimate(Hll hll);
+
+
+#endif
+/* SWIFT_HLL_H_ */
@@ -0,0 +1,325 @@
+/* File: linestore.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Bit packed, lazily allocated per line state. See linestore.h for
+ * details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -LineStore
+ *      3. Utility Functions
+ *          -fieldMask
+ *          -getField
+ *          -setField
+ *          -chunkWords
+ *          -allocateChunk
+ *          -widen
+ *      4. LineStore Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <limits.h>
+#include "linestore.h"
+
+/* Bits per packed word */
+#define WORD_BITS ((int)(sizeof(unsigned long) * CHAR_BIT))
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* LineStore
+ *
+ * Line l lives in chunk l >> chunkShift. Within a chunk, line i's tag
+ * is the width bits starting at bit i * width of the tag words, low bits
+ * first, and may span two words.
+ *
+ * @param   lines           number of lines
+ * @param   chunkShift      log2 of the lines per chunk
+ * @param   chunkLines      lines per chunk, a power of two of at least
+ *                          WORD_BITS
+ * @param   chunks          number of chunks
+ * @param   width           bits per tag, 1 to WORD_BITS
+ * @param   tags            packed tags of each chunk (NULL until filled)
+ * @param   dirty           dirty bitmap of each chunk (NULL until filled)
+ */
+
+struct LineStore_ {
+    int lines;
+    int chunkShift;
+    int chunkLines;
+    int chunks;
+    int width;
+    unsigned long** tags;
+    unsigned long** dirty;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* fieldMask
+ *
+ * Returns the low width bits set.
+ */
+
+static unsigned long fieldMask(int width)
+{
+    return (width >= WORD_BITS) ? ~0UL : (1UL << width) - 1;
+}
+
+/* getField
+ *
+ * Reads the width bit field at bit of words.
+ */
+
+static unsigned long getField(const unsigned long* words, unsigned long bit, int width)
+{
+    unsigned long word, value;
+    int shift;
+
+    word = bit / WORD_BITS;
+    shift = (int)(bit % WORD_BITS);
+
+    value = words[word] >> shift;
+    if(shift + width > WORD_BITS)
+    {
+        value |= words[word + 1] << (WORD_BITS - shift);
+    }
+
+    return value & fieldMask(width);
+}
+
+/* setField
+ *
+ * Writes value, which fits in width bits, to the field at bit of words.
+ */
+
+static void setField(unsigned long* words, unsigned long bit, int width, unsigned long value)
+{
+    unsigned long word, mask;
+    int shift;
+
+    word = bit / WORD_BITS;
+    shift = (int)(bit % WORD_BITS);
+    mask = fieldMask(width);
+
+    words[word] = (words[word] & ~(mask << shift)) | (value << shift);
+    if(shift + width > WORD_BITS)
+    {
+        words[word + 1] = (words[word + 1] & ~(mask >> (WORD_BITS - shift))) | (value >> (WORD_BITS - shift));
+    }
+}
+
+/* chunkWords
+ *
+ * Returns the words of packed tags in a chunk at width bits per tag.
+ */
+
+static unsigned long chunkWords(LineStore store, int width)
+{
+    return (unsigned long)store->chunkLines * (unsigned long)width / WORD_BITS;
+}
+
+/* allocateChunk
+ *
+ * Gives chunk its tags and dirty bits, all zero.
+ */
+
+static void allocateChunk(LineStore store, int chunk)
+{
+    store->tags[chunk] = (unsigned long*)calloc(chunkWords(store, store->width), sizeof(unsigned long));
+    store->dirty[chunk] = (unsigned long*)calloc(store->chunkLines / WORD_BITS, sizeof(unsigned long));
+    assert(store->tags[chunk] != NULL && store->dirty[chunk] != NULL);
+}
+
+/* widen
+ *
+ * Repacks the tags of every allocated chunk at width bits.
+ */
+
+static void widen(LineStore store, int width)
+{
+    unsigned long* packed;
+    unsigned long i;
+    int chunk;
+
+    for(chunk = 0; chunk < store->chunks; chunk++)
+    {
+        if(store->tags[chunk] == NULL)
+        {
+            continue;
+        }
+
+        packed = (unsigned long*)calloc(chunkWords(store, width), sizeof(unsigned long));
+        assert(packed != NULL);
+
+        for(i = 0; i < (unsigned long)store->chunkLines; i++)
+        {
+            setField(packed, i * width, width, getField(store->tags[chunk], i * store->width, store->width));
+        }
+
+        free(store->tags[chunk]);
+        store->tags[chunk] = packed;
+    }
+
+    store->width = width;
+}
+
+/********************************
+ *   4. LineStore Functions     *
+ ********************************/
+
+/* createLineStore
+ * ...
+ */
+
+LineStore createLineStore(int lines)
+{
+    LineStore store;
+
+    if(lines <= 0)
+    {
+        fprintf(stderr, "Invalid line store size.\n");
+        return NULL;
+    }
+
+    store = (LineStore)malloc(sizeof(struct LineStore_));
+    assert(store != NULL);
+
+    /* Small caches get one chunk of about the lines they have */
+    store->lines = lines;
+    store->chunkShift = 0;
+    while((1 << store->chunkShift) < WORD_BITS ||
+          ((1 << store->chunkShift) < lines && (1 << store->chunkShift) < LINESTORE_CHUNK))
+    {
+        store->chunkShift++;
+    }
+    store->chunkLines = 1 << store->chunkShift;
+    store->chunks = (int)(((unsigned long)lines + store->chunkLines - 1) / store->chunkLines);
+    store->width = 1;
+
+    store->tags = (unsigned long**)calloc(store->chunks, sizeof(unsigned long*));
+    store->dirty = (unsigned long**)calloc(store->chunks, sizeof(unsigned long*));
+    assert(store->tags != NULL && store->dirty != NULL);
+
+    return store;
+}
+
+/* destroyLineStore
+ * ...
+ */
+
+void destroyLineStore(LineStore store)
+{
+    int chunk;
+
+    if(store != NULL)
+    {
+        for(chunk = 0; chunk < store->chunks; chunk++)
+        {
+            free(store->tags[chunk]);
+            free(store->dirty[chunk]);
+        }
+
+        free(store->tags);
+        free(store->dirty);
+        free(store);
+    }
+}
+
+/* lineStoreFill
+ * ...
+ */
+
+void lineStoreFill(LineStore store, int line, unsigned long tag, int dirty)
+{
+    unsigned long* bits;
+    unsigned long offset;
+    int chunk, width;
+
+    assert(line >= 0 && line < store->lines);
+
+    if((tag & ~fieldMask(store->width)) != 0)
+    {
+        width = store->width;
+        while((tag & ~fieldMask(width)) != 0)
+        {
+            width++;
+        }
+
+        widen(store, width);
+    }
+
+    chunk = line >> store->chunkShift;
+    offset = (unsigned long)(line & (store->chunkLines - 1));
+
+    if(store->tags[chunk] == NULL)
+    {
+        allocateChunk(store, chunk);
+    }
+
+    setField(store->tags[chunk], offset * store->width, store->width, tag);
+
+    bits = &store->dirty[chunk][offset / WORD_BITS];
+    *bits = (*bits & ~(1UL << (offset % WORD_BITS))) | ((unsigned long)(dirty != 0) << (offset % WORD_BITS));
+}
+
+/* lineStoreTag
+ * ...
+ */
+
+unsigned long lineStoreTag(LineStore store, int line)
+{
+    const unsigned long* tags;
+
+    tags = store->tags[line >> store->chunkShift];
+    if(tags == NULL)
+    {
+        return 0;
+    }
+
+    return getField(tags, (unsigned long)(line & (store->chunkLines - 1)) * store->width, store->width);
+}
+
+/* lineStoreDirty
+ * ...
+ */
+
+int lineStoreDirty(LineStore store, int line)
+{
+    const unsigned long* dirty;
+    unsigned long offset;
+
+    dirty = store->dirty[line >> store->chunkShift];
+    if(dirty == NULL)
+    {
+        return 0;
+    }
+
+    offset = (unsigned long)(line & (store->chunkLines - 1));
+
+    return (int)((dirty[offset / WORD_BITS] >> (offset % WORD_BITS)) & 1);
+}
+
+/* lineStoreSetDirty
+ * ...
+ */
+
+void lineStoreSetDirty(LineStore store, int line)
+{
+    unsigned long offset;
+
+    assert(store->dirty[line >> store->chunkShift] != NULL);
+
+    offset = (unsigned long)(line & (store->chunkLines - 1));
+    store->dirty[line >> store->chunkShift][offset / WORD_BITS] |= 1UL << (offset % WORD_BITS);
+}
@@ -0,0 +1,106 @@
+/* File: linestore.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Per line state of the fully associative cache: the tag each line
+ * holds and its dirty bit. Tags are bit packed at the width the largest
+ * tag seen so far needs, so a trace of 32 bit addresses in 4 byte blocks
+ * costs 30 bits a line rather than a 64 bit tag plus two ints. The
+ * width starts at one bit and every stored tag is repacked when a wider
+ * one arrives, which happens at most once per bit. Dirty bits are a
+ * bitmap alongside.
+ *
+ * Lines are stored in chunks of LINESTORE_CHUNK that are only allocated
+ * when a line in them is first filled, so a huge cache that a trace
+ * never fills costs nothing for the lines it leaves untouched. Lines
+ * that have not been filled read back as tag 0, clean.
+ */
+
+#ifndef SWIFT_LINESTORE_H_
+#define SWIFT_LINESTORE_H_
+
+/* Lines per lazily allocated chunk */
+#define LINESTORE_CHUNK 65536
+
+/* Typedefs */
+typedef struct LineStore_* LineStore;
+
+
+/* createLineStore
+ *
+ * Function to create the state for lines 0 to lines - 1, none filled.
+ * Returns the new store on success and NULL on failure.
+ *
+ * @param   lines           number of lines
+ *
+ * @return  success         new LineStore
+ * @return  failure         NULL
+ */
+
+LineStore createLineStore(int lines);
+
+/* destroyLineStore
+ *
+ * Frees all memory held by the store. Passing NULL does nothing.
+ *
+ * @param   store           store to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyLineStore(LineStore store);
+
+/* lineStoreFill
+ *
+ * Places a block in line.
+ *
+ * @param   store           target store
+ * @param   line            line number
+ * @param   tag             tag of the new block
+ * @param   dirty           1 if the block starts dirty, else 0
+ *
+ * @return  void
+ */
+
+void lineStoreFill(LineStore store, int line, unsigned long tag, int dirty);
+
+/* lineStoreTag
+ *
+ * Returns the tag held in line.
+ *
+ * @param   store           target store
+ * @param   line            line number
+ *
+ * @return  unsigned long   tag, 0 if the line was never filled
+ */
+
+unsigned long lineStoreTag(LineStore store, int line);
+
+/* lineStoreDirty
+ *
+ * Returns the dirty bit of line.
+ *
+ * @param   store           target store
+ * @param   line            line number
+ *
+ * @return  dirty           1
+ * @return  clean           0
+ */
+
+int lineStoreDirty(LineStore store, int line);
+
+/* lineStoreSetDirty
+ *
+ * Marks the filled line dirty.
+ *
+ * @param   store           target store
+ * @param   line            line number
+ *
+ * @return  void
+ */
+
+void lineStoreSetDirty(LineStore store, int line);
+
+
+#endif
+/* SWIFT_LINESTORE_H_ */
@@ -0,0 +1,235 @@
+/* File: mshr.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Miss status holding registers. See mshr.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -MshrEntry
+ *          -MshrFile
+ *      3. Utility Functions
+ *          -retireFirst
+ *      4. MshrFile Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "mshr.h"
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* MshrEntry
+ *
+ * @param   block           block address being filled
+ * @param   done            cycle the fill returns
+ */
+
+typedef struct MshrEntry_ {
+    unsigned long block;
+    unsigned long done;
+} MshrEntry;
+
+/* MshrFile
+ *
+ * @param   entries         number of registers
+ * @param   busy            registers in use
+ * @param   now             cycle the file has been advanced to
+ * @param   queue           busy registers, earliest fill first
+ * @param   stats           counters
+ */
+
+struct MshrFile_ {
+    int entries;
+    int busy;
+    unsigned long now;
+    MshrEntry* queue;
+    MshrStats stats;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* retireFirst
+ *
+ * Moves time to the return of the earliest outstanding fill and frees
+ * its register, counting the cycles since the last event towards MLP.
+ */
+
+static void retireFirst(MshrFile mshrs)
+{
+    unsigned long done, span;
+
+    done = mshrs->queue[0].done;
+    span = (done > mshrs->now) ? done - mshrs->now : 0;
+
+    mshrs->stats.busyCycles += span;
+    mshrs->stats.missCycles += span * (unsigned long)mshrs->busy;
+
+    if(done > mshrs->now)
+    {
+        mshrs->now = done;
+    }
+
+    mshrs->busy--;
+    memmove(mshrs->queue, mshrs->queue + 1, sizeof(MshrEntry) * mshrs->busy);
+}
+
+/********************************
+ *    4. MshrFile Functions     *
+ ********************************/
+
+/* createMshrFile
+ * ...
+ */
+
+MshrFile createMshrFile(int entries)
+{
+    MshrFile mshrs;
+
+    if(entries <= 0)
+    {
+        fprintf(stderr, "Invalid number of MSHRs.\n");
+        return NULL;
+    }
+
+    mshrs = (MshrFile)malloc(sizeof(struct MshrFile_));
+    assert(mshrs != NULL);
+
+    mshrs->queue = (MshrEntry*)malloc(sizeof(MshrEntry) * entries);
+    assert(mshrs->queue != NULL);
+
+    mshrs->entries = entries;
+    mshrs->busy = 0;
+    mshrs->now = 0;
+    memset(&mshrs->stats, 0, sizeof(MshrStats));
+
+    return mshrs;
+}
+
+/* destroyMshrFile
+ * ...
+ */
+
+void destroyMshrFile(MshrFile mshrs)
+{
+    if(mshrs != NULL)
+    {
+        free(mshrs->queue);
+        free(mshrs);
+    }
+}
+
+/* mshrAdvance
+ * ...
+ */
+
+void mshrAdvance(MshrFile mshrs, unsigned long now)
+{
+    while(mshrs->busy > 0 && mshrs->queue[0].done <= now)
+    {
+        retireFirst(mshrs);
+    }
+
+    if(now > mshrs->now)
+    {
+        if(mshrs->busy > 0)
+        {
+            mshrs->stats.busyCycles += now - mshrs->now;
+            mshrs->stats.missCycles += (now - mshrs->now) * (unsigned long)mshrs->busy;
+        }
+        mshrs->now = now;
+    }
+}
+
+/* mshrMerge
+ * ...
+ */
+
+int mshrMerge(MshrFile mshrs, unsigned long block)
+{
+    int i;
+
+    for(i = 0; i < mshrs->busy; i++)
+    {
+        if(mshrs->queue[i].block == block)
+        {
+            mshrs->stats.merged++;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* mshrIssue
+ * ...
+ */
+
+unsigned long mshrIssue(MshrFile mshrs, unsigned long now)
+{
+    if(mshrs->busy < mshrs->entries)
+    {
+        return now;
+    }
+
+    mshrs->stats.fullStalls++;
+    retireFirst(mshrs);
+
+    if(mshrs->now > now)
+    {
+        mshrs->stats.stallCycles += mshrs->now - now;
+        return mshrs->now;
+    }
+
+    return now;
+}
+
+/* mshrAllocate
+ * ...
+ */
+
+void mshrAllocate(MshrFile mshrs, unsigned long block, unsigned long issue, unsigned long latency)
+{
+    unsigned long done;
+    int i;
+
+    /* Insert in fill order; with one memory latency this is always the
+       end, so the shift is empty */
+    done = issue + latency;
+    i = mshrs->busy;
+    while(i > 0 && mshrs->queue[i - 1].done > done)
+    {
+        mshrs->queue[i] = mshrs->queue[i - 1];
+        i--;
+    }
+
+    mshrs->queue[i].block = block;
+    mshrs->queue[i].done = done;
+    mshrs->busy++;
+    mshrs->stats.misses++;
+
+    if(done > mshrs->stats.last)
+    {
+        mshrs->stats.last = done;
+    }
+}
+
+/* mshrGetStats
+ * ...
+ */
+
+void mshrGetStats(MshrFile mshrs, MshrStats* stats)
+{
+    *stats = mshrs->stats;
+}
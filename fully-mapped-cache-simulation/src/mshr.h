@@ -0,0 +1,144 @@
+/* File: mshr.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Miss status holding registers. Turns a cache into a non-blocking one
+ * for timing: a miss takes a free register until its fill returns, and
+ * the access stream goes on without waiting for it. An access to a
+ * block whose fill is still on its way merges into that register, and
+ * misses to different blocks overlap up to the number of registers.
+ * Only when every register is busy does the stream stall, until the
+ * earliest fill returns.
+ *
+ * The registers are kept in a small array ordered by the time each fill
+ * returns, so completions are retired in time order whatever latency
+ * each miss had. Along the way the file measures memory level
+ * parallelism (MLP): the average number of misses outstanding over the
+ * cycles in which there was at least one.
+ */
+
+#ifndef SWIFT_MSHR_H_
+#define SWIFT_MSHR_H_
+
+/* Typedefs */
+typedef struct MshrFile_* MshrFile;
+
+/* MshrStats
+ *
+ * Counters kept by an MshrFile.
+ *
+ * @param   misses          misses that took a register
+ * @param   merged          accesses to a block with a fill outstanding
+ * @param   fullStalls      misses that found every register busy
+ * @param   stallCycles     cycles spent waiting for a free register
+ * @param   busyCycles      cycles with at least one miss outstanding
+ * @param   missCycles      sum over cycles of the misses outstanding
+ * @param   last            cycle the last outstanding fill returns
+ */
+
+typedef struct MshrStats_ {
+    unsigned long misses;
+    unsigned long merged;
+    unsigned long fullStalls;
+    unsigned long stallCycles;
+    unsigned long busyCycles;
+    unsigned long missCycles;
+    unsigned long last;
+} MshrStats;
+
+
+/* createMshrFile
+ *
+ * Function to create a file of idle registers. Returns the new file on
+ * success and NULL on failure.
+ *
+ * @param   entries         number of registers (1 = a blocking cache)
+ *
+ * @return  success         new MshrFile
+ * @return  failure         NULL
+ */
+
+MshrFile createMshrFile(int entries);
+
+/* destroyMshrFile
+ *
+ * Frees all memory held by the file. Passing NULL does nothing.
+ *
+ * @param   mshrs           file to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyMshrFile(MshrFile mshrs);
+
+/* mshrAdvance
+ *
+ * Moves time forward to now, retiring every fill that has returned by
+ * then. now must not go backwards.
+ *
+ * @param   mshrs           target file
+ * @param   now             current cycle
+ *
+ * @return  void
+ */
+
+void mshrAdvance(MshrFile mshrs, unsigned long now);
+
+/* mshrMerge
+ *
+ * Checks whether block has a fill outstanding and counts a merged
+ * access if so.
+ *
+ * @param   mshrs           target file, advanced to the current cycle
+ * @param   block           block address of the access
+ *
+ * @return  outstanding     1
+ * @return  not outstanding 0
+ */
+
+int mshrMerge(MshrFile mshrs, unsigned long block);
+
+/* mshrIssue
+ *
+ * Returns the cycle a miss wanting to go out at now can be issued. If
+ * every register is busy the miss waits for the earliest fill to
+ * return, and that register is freed for it.
+ *
+ * @param   mshrs           target file, advanced to now
+ * @param   now             current cycle
+ *
+ * @return  unsigned long   cycle the miss can be issued
+ */
+
+unsigned long mshrIssue(MshrFile mshrs, unsigned long now);
+
+/* mshrAllocate
+ *
+ * Takes a register for a miss on block issued at the cycle given by
+ * mshrIssue, whose fill takes latency cycles.
+ *
+ * @param   mshrs           target file
+ * @param   block           block address of the miss
+ * @param   issue           cycle the miss was issued
+ * @param   latency         cycles until the fill returns
+ *
+ * @return  void
+ */
+
+void mshrAllocate(MshrFile mshrs, unsigned long block, unsigned long issue, unsigned long latency);
+
+/* mshrGetStats
+ *
+ * Copies out the counters.
+ *
+ * @param   mshrs           target file
+ * @param   stats           filled with the counters
+ *
+ * @return  void
+ */
+
+void mshrGetStats(MshrFile mshrs, MshrStats* stats);
+
+
+#endif
+/* SWIFT_MSHR_H_ */
@@ -0,0 +1,587 @@
+/* File: objcache.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Variable size object cache. See objcache.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -ObjectCache
+ *      3. Entry Helpers
+ *          -allocEntry
+ *          -growIndex
+ *          -lruUnlink
+ *          -lruPushFront
+ *      4. Heap Helpers
+ *          -heapSwap
+ *          -heapUp
+ *          -heapDown
+ *          -heapRemove
+ *      5. Policy Helpers
+ *          -admitEntry
+ *          -removeEntry
+ *          -evictOne
+ *      6. ObjectCache Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "objcache.h"
+#include "tagindex.h"
+
+/* Starting number of entry slots; the pool doubles as needed */
+#define OBJECT_INITIAL_ENTRIES 1024
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* ObjectCache
+ *
+ * Entries live in a pool of parallel arrays that doubles when full;
+ * freed entries are chained through next. The tag index maps an object
+ * id to its entry and is rebuilt at twice the size whenever the number
+ * of resident objects reaches what it was sized for.
+ *
+ * @param   policy          OBJECT_ constant
+ * @param   capacity        size of the cache in bytes
+ * @param   used            bytes currently held
+ * @param   objects         objects currently held
+ * @param   hits            requests that found the object
+ * @param   misses          requests that did not
+ * @param   byteHits        bytes served from the cache
+ * @param   byteMisses      bytes fetched on misses
+ * @param   evictions       objects evicted
+ * @param   bypassed        objects too large to admit
+ * @param   inflation       GDSF aging value L
+ * @param   poolSize        number of entry slots allocated
+ * @param   freeEntries     head of the free entry chain
+ * @param   ids             object id held in each entry
+ * @param   sizes           object size held in each entry
+ * @param   freqs           GDSF request count of each entry
+ * @param   priorities      GDSF priority of each entry
+ * @param   heapPos         GDSF position of each entry in heap
+ * @param   prev            LRU previous entry
+ * @param   next            LRU next entry / free chain
+ * @param   head            LRU most recently used entry
+ * @param   tail            LRU least recently used entry
+ * @param   heap            GDSF min heap of entries by priority
+ * @param   index           object id to entry
+ * @param   indexEntries    number of objects the index was sized for
+ */
+
+struct ObjectCache_ {
+    int policy;
+    unsigned long capacity;
+    unsigned long used;
+    unsigned long objects;
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long byteHits;
+    unsigned long byteMisses;
+    unsigned long evictions;
+    unsigned long bypassed;
+    double inflation;
+    int poolSize;
+    int freeEntries;
+    unsigned long* ids;
+    unsigned long* sizes;
+    unsigned long* freqs;
+    double* priorities;
+    int* heapPos;
+    int* prev;
+    int* next;
+    int head;
+    int tail;
+    int* heap;
+    TagIndex index;
+    int indexEntries;
+};
+
+/********************************
+ *      3. Entry Helpers        *
+ ********************************/
+
+/* allocEntry
+ *
+ * Takes an entry off the free chain, growing the pool first (to
+ * OBJECT_INITIAL_ENTRIES, then doubling) if the chain is empty.
+ */
+
+static int allocEntry(ObjectCache cache)
+{
+    int e, i, size;
+
+    if(cache->freeEntries == -1)
+    {
+        size = (cache->poolSize == 0) ? OBJECT_INITIAL_ENTRIES : cache->poolSize * 2;
+
+        cache->ids = (unsigned long*)realloc(cache->ids, sizeof(unsigned long) * size);
+        cache->sizes = (unsigned long*)realloc(cache->sizes, sizeof(unsigned long) * size);
+        cache->freqs = (unsigned long*)realloc(cache->freqs, sizeof(unsigned long) * size);
+        cache->priorities = (double*)realloc(cache->priorities, sizeof(double) * size);
+        cache->heapPos = (int*)realloc(cache->heapPos, sizeof(int) * size);
+        cache->prev = (int*)realloc(cache->prev, sizeof(int) * size);
+        cache->next = (int*)realloc(cache->next, sizeof(int) * size);
+        cache->heap = (int*)realloc(cache->heap, sizeof(int) * size);
+        assert(cache->ids != NULL && cache->sizes != NULL && cache->freqs != NULL);
+        assert(cache->priorities != NULL && cache->heapPos != NULL && cache->heap != NULL);
+        assert(cache->prev != NULL && cache->next != NULL);
+
+        for(i = cache->poolSize; i < size; i++)
+        {
+            cache->next[i] = (i == size - 1) ? -1 : i + 1;
+        }
+
+        cache->freeEntries = cache->poolSize;
+        cache->poolSize = size;
+    }
+
+    e = cache->freeEntries;
+    cache->freeEntries = cache->next[e];
+
+    return e;
+}
+
+/* growIndex
+ *
+ * Replaces the tag index with one sized for twice as many objects and
+ * reinserts every resident object. Called when the object count reaches
+ * the current size, so the cost is amortized O(1) per admission.
+ */
+
+static void growIndex(ObjectCache cache)
+{
+    int e;
+
+    destroyTagIndex(cache->index);
+    cache->indexEntries = cache->indexEntries * 2;
+    cache->index = createTagIndex(cache->indexEntries);
+    assert(cache->index != NULL);
+
+    for(e = cache->head; e != -1; e = cache->next[e])
+    {
+        tagIndexInsert(cache->index, cache->ids[e], e);
+    }
+}
+
+/* lruUnlink
+ *
+ * Takes an entry out of the recency list.
+ */
+
+static void lruUnlink(ObjectCache cache, int e)
+{
+    if(cache->prev[e] == -1)
+    {
+        cache->head = cache->next[e];
+    }
+    else
+    {
+        cache->next[cache->prev[e]] = cache->next[e];
+    }
+
+    if(cache->next[e] == -1)
+    {
+        cache->tail = cache->prev[e];
+    }
+    else
+    {
+        cache->prev[cache->next[e]] = cache->prev[e];
+    }
+}
+
+/* lruPushFront
+ *
+ * Puts an entry at the most recently used end of the recency list.
+ */
+
+static void lruPushFront(ObjectCache cache, int e)
+{
+    cache->prev[e] = -1;
+    cache->next[e] = cache->head;
+
+    if(cache->head == -1)
+    {
+        cache->tail = e;
+    }
+    else
+    {
+        cache->prev[cache->head] = e;
+    }
+
+    cache->head = e;
+}
+
+/********************************
+ *       4. Heap Helpers        *
+ ********************************/
+
+/* heapSwap
+ *
+ * Swaps two heap positions and updates the entries' back pointers.
+ */
+
+static void heapSwap(ObjectCache cache, int a, int b)
+{
+    int e;
+
+    e = cache->heap[a];
+    cache->heap[a] = cache->heap[b];
+    cache->heap[b] = e;
+
+    cache->heapPos[cache->heap[a]] = a;
+    cache->heapPos[cache->heap[b]] = b;
+}
+
+/* heapUp
+ *
+ * Moves the entry at position i towards the root while it has a smaller
+ * priority than its parent.
+ */
+
+static void heapUp(ObjectCache cache, int i)
+{
+    int parent;
+
+    while(i > 0)
+    {
+        parent = (i - 1) / 2;
+
+        if(cache->priorities[cache->heap[parent]] <= cache->priorities[cache->heap[i]])
+        {
+            break;
+        }
+
+        heapSwap(cache, i, parent);
+        i = parent;
+    }
+}
+
+/* heapDown
+ *
+ * Moves the entry at position i towards the leaves while either child
+ * has a smaller priority.
+ */
+
+static void heapDown(ObjectCache cache, int i)
+{
+    int child, n;
+
+    n = (int)cache->objects;
+
+    while(2 * i + 1 < n)
+    {
+        child = 2 * i + 1;
+
+        if(child + 1 < n &&
+           cache->priorities[cache->heap[child + 1]] < cache->priorities[cache->heap[child]])
+        {
+            child++;
+        }
+
+        if(cache->priorities[cache->heap[i]] <= cache->priorities[cache->heap[child]])
+        {
+            break;
+        }
+
+        heapSwap(cache, i, child);
+        i = child;
+    }
+}
+
+/* heapRemove
+ *
+ * Removes an entry from the heap. Must be called before objects is
+ * decremented.
+ */
+
+static void heapRemove(ObjectCache cache, int e)
+{
+    int i, last;
+
+    i = cache->heapPos[e];
+    last = (int)cache->objects - 1;
+
+    if(i != last)
+    {
+        heapSwap(cache, i, last);
+        cache->objects--;
+        heapUp(cache, i);
+        heapDown(cache, i);
+        cache->objects++;
+    }
+}
+
+/********************************
+ *      5. Policy Helpers       *
+ ********************************/
+
+/* admitEntry
+ *
+ * Places a new object in the cache. The caller has already made room.
+ */
+
+static void admitEntry(ObjectCache cache, unsigned long id, unsigned long size, unsigned long freq)
+{
+    int e;
+
+    if(cache->objects + 1 > (unsigned long)cache->indexEntries)
+    {
+        growIndex(cache);
+    }
+
+    e = allocEntry(cache);
+
+    cache->ids[e] = id;
+    cache->sizes[e] = size;
+    cache->freqs[e] = freq;
+
+    lruPushFront(cache, e);
+    tagIndexInsert(cache->index, id, e);
+
+    if(cache->policy == OBJECT_GDSF)
+    {
+        cache->priorities[e] = cache->inflation + (double)freq / (double)size;
+        cache->heap[cache->objects] = e;
+        cache->heapPos[e] = (int)cache->objects;
+        cache->objects++;
+        heapUp(cache, cache->heapPos[e]);
+    }
+    else
+    {
+        cache->objects++;
+    }
+
+    cache->used += size;
+}
+
+/* removeEntry
+ *
+ * Drops an object from every structure and frees its entry.
+ */
+
+static void removeEntry(ObjectCache cache, int e)
+{
+    if(cache->policy == OBJECT_GDSF)
+    {
+        heapRemove(cache, e);
+    }
+
+    lruUnlink(cache, e);
+    tagIndexRemove(cache->index, cache->ids[e]);
+
+    cache->used -= cache->sizes[e];
+    cache->objects--;
+
+    cache->next[e] = cache->freeEntries;
+    cache->freeEntries = e;
+}
+
+/* evictOne
+ *
+ * Evicts the policy's choice of victim.
+ */
+
+static void evictOne(ObjectCache cache)
+{
+    int victim;
+
+    if(cache->policy == OBJECT_GDSF)
+    {
+        victim = cache->heap[0];
+        cache->inflation = cache->priorities[victim];
+    }
+    else
+    {
+        victim = cache->tail;
+    }
+
+    removeEntry(cache, victim);
+    cache->evictions++;
+}
+
+/********************************
+ *  6. ObjectCache Functions    *
+ ********************************/
+
+/* parseObjectPolicy
+ * ...
+ */
+
+int parseObjectPolicy(const char* name)
+{
+    if(strcmp(name, "lru") == 0)
+    {
+        return OBJECT_LRU;
+    }
+    else if(strcmp(name, "gdsf") == 0)
+    {
+        return OBJECT_GDSF;
+    }
+
+    return -1;
+}
+
+/* createObjectCache
+ * ...
+ */
+
+ObjectCache createObjectCache(unsigned long capacity, int policy)
+{
+    ObjectCache cache;
+
+    /* Validate Inputs */
+    if(capacity == 0 || (policy != OBJECT_LRU && policy != OBJECT_GDSF))
+    {
+        fprintf(stderr, "Invalid object cache parameters.\n");
+        return NULL;
+    }
+
+    cache = (ObjectCache)malloc(sizeof(struct ObjectCache_));
+    assert(cache != NULL);
+
+    cache->policy = policy;
+    cache->capacity = capacity;
+    cache->used = 0;
+    cache->objects = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->byteHits = 0;
+    cache->byteMisses = 0;
+    cache->evictions = 0;
+    cache->bypassed = 0;
+    cache->inflation = 0.0;
+
+    /* The pool starts empty; allocEntry sizes it on first use */
+    cache->poolSize = 0;
+    cache->freeEntries = -1;
+    cache->ids = NULL;
+    cache->sizes = NULL;
+    cache->freqs = NULL;
+    cache->priorities = NULL;
+    cache->heapPos = NULL;
+    cache->prev = NULL;
+    cache->next = NULL;
+    cache->heap = NULL;
+    cache->head = -1;
+    cache->tail = -1;
+
+    cache->indexEntries = OBJECT_INITIAL_ENTRIES;
+    cache->index = createTagIndex(cache->indexEntries);
+    assert(cache->index != NULL);
+
+    return cache;
+}
+
+/* destroyObjectCache
+ * ...
+ */
+
+void destroyObjectCache(ObjectCache cache)
+{
+    if(cache != NULL)
+    {
+        free(cache->ids);
+        free(cache->sizes);
+        free(cache->freqs);
+        free(cache->priorities);
+        free(cache->heapPos);
+        free(cache->prev);
+        free(cache->next);
+        free(cache->heap);
+        destroyTagIndex(cache->index);
+        free(cache);
+    }
+}
+
+/* objectCacheAccess
+ * ...
+ */
+
+int objectCacheAccess(ObjectCache cache, unsigned long id, unsigned long size)
+{
+    int e;
+    unsigned long freq;
+
+    assert(size > 0);
+
+    e = tagIndexFind(cache->index, id);
+
+    if(e != -1 && cache->sizes[e] == size)
+    {
+        cache->hits++;
+        cache->byteHits += size;
+        cache->freqs[e]++;
+
+        lruUnlink(cache, e);
+        lruPushFront(cache, e);
+
+        if(cache->policy == OBJECT_GDSF)
+        {
+            cache->priorities[e] = cache->inflation + (double)cache->freqs[e] / (double)size;
+            heapDown(cache, cache->heapPos[e]);
+        }
+
+        return 1;
+    }
+
+    if(size > cache->capacity)
+    {
+        /* Too large to hold: a miss, and a copy at the old size is stale */
+        if(e != -1)
+        {
+            removeEntry(cache, e);
+        }
+
+        cache->misses++;
+        cache->byteMisses += size;
+        cache->bypassed++;
+        return 0;
+    }
+
+    freq = 1;
+
+    if(e != -1)
+    {
+        /* The object changed size: count the request as a hit but
+           readmit it at its new size, keeping its frequency */
+        cache->hits++;
+        cache->byteHits += size;
+        freq = cache->freqs[e] + 1;
+        removeEntry(cache, e);
+    }
+    else
+    {
+        cache->misses++;
+        cache->byteMisses += size;
+    }
+
+    while(cache->used + size > cache->capacity)
+    {
+        evictOne(cache);
+    }
+
+    admitEntry(cache, id, size, freq);
+
+    return (e != -1);
+}
+
+/* printObjectCache
+ * ...
+ */
+
+void printObjectCache(ObjectCache cache)
+{
+    printf("OBJECT HITS: %lu\nOBJECT MISSES: %lu\nBYTE HITS: %lu\nBYTE MISSES: %lu\n",
+           cache->hits, cache->misses, cache->byteHits, cache->byteMisses);
+    printf("EVICTIONS: %lu\nBYPASSED: %lu\nOBJECTS HELD: %lu\nBYTES HELD: %lu\n",
+           cache->evictions, cache->bypassed, cache->objects, cache->used);
+}
@@ -0,0 +1,102 @@
+/* File: objcache.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * An object (or page) cache: entries are whole objects of varying size
+ * rather than fixed BLOCK_SIZE lines, and the cache is bounded by the
+ * total number of bytes it holds. A miss may have to evict several
+ * objects to make room. The bytes in use are kept as a running total,
+ * so capacity accounting is O(1) per access.
+ *
+ * Policies:
+ *      lru     - size aware LRU: evict least recently used objects until
+ *                the new one fits.
+ *      gdsf    - Greedy Dual Size Frequency: evict the object with the
+ *                smallest priority L + frequency / size, where L is the
+ *                priority of the last object evicted. Small, popular
+ *                objects stay; large, cold ones go first.
+ *
+ * Objects larger than the whole cache are never admitted and are counted
+ * as bypassed misses.
+ */
+
+#ifndef SWIFT_OBJCACHE_H_
+#define SWIFT_OBJCACHE_H_
+
+/* Object Policies */
+#define OBJECT_LRU 0
+#define OBJECT_GDSF 1
+
+/* Typedefs */
+typedef struct ObjectCache_* ObjectCache;
+
+
+/* parseObjectPolicy
+ *
+ * Converts a policy name ("lru" or "gdsf") into its OBJECT_ constant.
+ *
+ * @param   name            policy name
+ *
+ * @return  success         OBJECT_ constant
+ * @return  failure         -1
+ */
+
+int parseObjectPolicy(const char* name);
+
+/* createObjectCache
+ *
+ * Function to create an empty object cache. Returns the new cache on
+ * success and NULL on failure.
+ *
+ * @param   capacity        size of the cache in bytes
+ * @param   policy          OBJECT_ constant
+ *
+ * @return  success         new ObjectCache
+ * @return  failure         NULL
+ */
+
+ObjectCache createObjectCache(unsigned long capacity, int policy);
+
+/* destroyObjectCache
+ *
+ * Frees all memory held by the cache. Passing NULL does nothing.
+ *
+ * @param   cache           cache to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyObjectCache(ObjectCache cache);
+
+/* objectCacheAccess
+ *
+ * Requests an object. On a miss the object is admitted, evicting as
+ * many others as needed. If a cached object is requested with a new
+ * size, the new size replaces the old one. An object larger than the
+ * whole cache is bypassed and counted as a miss.
+ *
+ * @param   cache           target cache
+ * @param   id              object id
+ * @param   size            object size in bytes, at least 1
+ *
+ * @return  hit             1
+ * @return  miss            0
+ */
+
+int objectCacheAccess(ObjectCache cache, unsigned long id, unsigned long size);
+
+/* printObjectCache
+ *
+ * Prints the request and byte hit/miss counts, evictions, bypasses and
+ * current occupancy.
+ *
+ * @param   cache           target cache
+ *
+ * @return  void
+ */
+
+void printObjectCache(ObjectCache cache);
+
+
+#endif
+/* SWIFT_OBJCACHE_H_ */
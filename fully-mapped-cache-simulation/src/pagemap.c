@@ -0,0 +1,301 @@
+/* File: pagemap.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Virtual to physical address translation. See pagemap.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -PageMap
+ *      3. Utility Functions
+ *          -nextRandom
+ *          -log2Exact
+ *      4. PageMap Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "pagemap.h"
+#include "tagindex.h"
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* PageMap
+ *
+ * Frames are handed out per color: color c owns frames c, c + colors,
+ * c + 2 * colors, ..., visited in the shuffled order of order. The
+ * random and huge allocators are the one color case.
+ *
+ * @param   allocator       PAGEMAP_ constant
+ * @param   pageBits        log2 of the page size
+ * @param   colors          number of colors (1 unless allocator is color)
+ * @param   perColor        frames of each color
+ * @param   order           shuffled frame numbers within a color
+ * @param   next            allocations made so far from each color
+ * @param   owner           virtual page held by each frame
+ * @param   used            1 for each frame that holds a page
+ * @param   index           maps virtual page numbers to frames
+ * @param   pages           pages mapped so far
+ * @param   reclaims        frames taken back from an older page
+ * @param   seed            random number state
+ */
+
+struct PageMap_ {
+    int allocator;
+    int pageBits;
+    int colors;
+    unsigned long perColor;
+    int* order;
+    unsigned long* next;
+    unsigned long* owner;
+    char* used;
+    TagIndex index;
+    unsigned long pages;
+    unsigned long reclaims;
+    unsigned long seed;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* nextRandom
+ *
+ * Xorshift step, as the random replacement policy uses.
+ */
+
+static unsigned long nextRandom(PageMap map)
+{
+    map->seed ^= map->seed << 13;
+    map->seed ^= map->seed >> 7;
+    map->seed ^= map->seed << 17;
+
+    return map->seed;
+}
+
+/* log2Exact
+ *
+ * Returns log2(value) for a power of two, and -1 for anything else.
+ */
+
+static int log2Exact(long value)
+{
+    int bits;
+
+    if(value <= 0 || (value & (value - 1)) != 0)
+    {
+        return -1;
+    }
+
+    bits = 0;
+    while((1L << bits) < value)
+    {
+        bits++;
+    }
+
+    return bits;
+}
+
+/********************************
+ *    4. PageMap Functions      *
+ ********************************/
+
+/* parsePageMap
+ * ...
+ */
+
+int parsePageMap(const char* name)
+{
+    if(strcmp(name, "identity") == 0)
+    {
+        return PAGEMAP_IDENTITY;
+    }
+    else if(strcmp(name, "random") == 0)
+    {
+        return PAGEMAP_RANDOM;
+    }
+    else if(strcmp(name, "color") == 0)
+    {
+        return PAGEMAP_COLOR;
+    }
+    else if(strcmp(name, "huge") == 0)
+    {
+        return PAGEMAP_HUGE;
+    }
+
+    return -1;
+}
+
+/* createPageMap
+ * ...
+ */
+
+PageMap createPageMap(int allocator, long page_size, long phys_mem, int colors)
+{
+    PageMap map;
+    unsigned long frames, i, j;
+    int swap;
+
+    if(allocator == PAGEMAP_HUGE)
+    {
+        page_size = PAGEMAP_HUGE_SIZE;
+    }
+    if(allocator != PAGEMAP_COLOR)
+    {
+        colors = 1;
+    }
+
+    if(allocator < PAGEMAP_IDENTITY || allocator > PAGEMAP_HUGE || log2Exact(page_size) < 0 ||
+       log2Exact(colors) < 0 || phys_mem < page_size || phys_mem % page_size != 0 ||
+       phys_mem / page_size < colors || phys_mem / page_size > (1L << 28))
+    {
+        fprintf(stderr, "Invalid page map parameters.\n");
+        return NULL;
+    }
+
+    map = (PageMap)malloc(sizeof(struct PageMap_));
+    assert(map != NULL);
+
+    map->allocator = allocator;
+    map->pageBits = log2Exact(page_size);
+    map->colors = colors;
+    map->pages = 0;
+    map->reclaims = 0;
+    map->seed = 0x2545F4914F6CDD1DUL;
+    map->order = NULL;
+    map->next = NULL;
+    map->owner = NULL;
+    map->used = NULL;
+    map->index = NULL;
+
+    if(allocator == PAGEMAP_IDENTITY)
+    {
+        return map;
+    }
+
+    frames = (unsigned long)(phys_mem / page_size);
+    map->perColor = frames / (unsigned long)colors;
+
+    /* Fisher-Yates shuffle of the frames within a color */
+    map->order = (int*)malloc(sizeof(int) * map->perColor);
+    assert(map->order != NULL);
+    for(i = 0; i < map->perColor; i++)
+    {
+        map->order[i] = (int)i;
+    }
+    for(i = map->perColor - 1; i > 0; i--)
+    {
+        j = nextRandom(map) % (i + 1);
+        swap = map->order[i];
+        map->order[i] = map->order[j];
+        map->order[j] = swap;
+    }
+
+    map->next = (unsigned long*)calloc((size_t)colors, sizeof(unsigned long));
+    map->owner = (unsigned long*)malloc(sizeof(unsigned long) * frames);
+    map->used = (char*)calloc(frames, 1);
+    assert(map->next != NULL && map->owner != NULL && map->used != NULL);
+
+    map->index = createTagIndex((int)frames);
+    if(map->index == NULL)
+    {
+        destroyPageMap(map);
+        return NULL;
+    }
+
+    return map;
+}
+
+/* destroyPageMap
+ * ...
+ */
+
+void destroyPageMap(PageMap map)
+{
+    if(map != NULL)
+    {
+        destroyTagIndex(map->index);
+        free(map->order);
+        free(map->next);
+        free(map->owner);
+        free(map->used);
+        free(map);
+    }
+}
+
+/* pageMapTranslate
+ * ...
+ */
+
+unsigned long pageMapTranslate(PageMap map, unsigned long address)
+{
+    unsigned long page, frame, color;
+    int found;
+
+    if(map->allocator == PAGEMAP_IDENTITY)
+    {
+        return address;
+    }
+
+    page = address >> map->pageBits;
+    found = tagIndexFind(map->index, page);
+
+    if(found == -1)
+    {
+        /* First touch: take the next frame of the page's color, taking
+           it back from its page if memory is full */
+        color = page & (unsigned long)(map->colors - 1);
+        frame = (unsigned long)map->order[map->next[color] % map->perColor] * (unsigned long)map->colors + color;
+        map->next[color]++;
+
+        if(map->used[frame])
+        {
+            tagIndexRemove(map->index, map->owner[frame]);
+            map->reclaims++;
+        }
+
+        map->used[frame] = 1;
+        map->owner[frame] = page;
+        tagIndexInsert(map->index, page, (int)frame);
+        map->pages++;
+        found = (int)frame;
+    }
+
+    return ((unsigned long)found << map->pageBits) | (address & ((1UL << map->pageBits) - 1));
+}
+
+/* pageMapPageBits
+ * ...
+ */
+
+int pageMapPageBits(PageMap map)
+{
+    return map->pageBits;
+}
+
+/* pageMapPages
+ * ...
+ */
+
+unsigned long pageMapPages(PageMap map)
+{
+    return map->pages;
+}
+
+/* pageMapReclaims
+ * ...
+ */
+
+unsigned long pageMapReclaims(PageMap map)
+{
+    return map->reclaims;
+}
@@ -0,0 +1,133 @@
+/* File: pagemap.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Virtual to physical address translation. Traces hold virtual
+ * addresses, while caches past L1 and DRAM see physical ones. A page
+ * map gives every virtual page a physical frame the first time the page
+ * is touched, the way an operating system would, using one of these
+ * allocators:
+ *
+ *      identity        physical = virtual (no translation)
+ *      random          a random free frame
+ *      color           a random free frame of the page's color (page
+ *                      number modulo the number of colors), so the bits
+ *                      a physically indexed cache takes its set from
+ *                      match the virtual address
+ *      huge            random allocation of 2MB frames (PAGEMAP_HUGE_SIZE),
+ *                      as with transparent huge pages
+ *
+ * Translations are kept in a tag index (tagindex.h), so each lookup is
+ * one hash probe. Physical memory is finite: once every frame is in use
+ * the oldest allocation is taken back for the new page.
+ */
+
+#ifndef SWIFT_PAGEMAP_H_
+#define SWIFT_PAGEMAP_H_
+
+/* Allocators */
+#define PAGEMAP_IDENTITY 0
+#define PAGEMAP_RANDOM 1
+#define PAGEMAP_COLOR 2
+#define PAGEMAP_HUGE 3
+
+/* Defaults */
+#define PAGEMAP_PHYS_MEM (1L << 32)
+#define PAGEMAP_COLORS 64
+
+/* Frame size of the huge allocator */
+#define PAGEMAP_HUGE_SIZE (1L << 21)
+
+/* Typedefs */
+typedef struct PageMap_* PageMap;
+
+
+/* parsePageMap
+ *
+ * Maps an allocator name ("identity", "random", "color" or "huge") to
+ * its PAGEMAP_ constant.
+ *
+ * @param   name            allocator name
+ *
+ * @return  success         PAGEMAP_ constant
+ * @return  failure         -1
+ */
+
+int parsePageMap(const char* name);
+
+/* createPageMap
+ *
+ * Function to create a page map with no pages mapped. Returns the new
+ * map on success and NULL on failure.
+ *
+ * @param   allocator       PAGEMAP_ constant
+ * @param   page_size       page size in bytes (a power of two); ignored
+ *                          by the huge allocator
+ * @param   phys_mem        physical memory in bytes (a multiple of the
+ *                          page size)
+ * @param   colors          number of page colors (a power of two), used
+ *                          by the color allocator
+ *
+ * @return  success         new PageMap
+ * @return  failure         NULL
+ */
+
+PageMap createPageMap(int allocator, long page_size, long phys_mem, int colors);
+
+/* destroyPageMap
+ *
+ * Frees all memory held by the map. Passing NULL does nothing.
+ *
+ * @param   map             map to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyPageMap(PageMap map);
+
+/* pageMapTranslate
+ *
+ * Returns the physical address of a virtual one, mapping its page if
+ * this is the first touch.
+ *
+ * @param   map             target map
+ * @param   address         virtual byte address
+ *
+ * @return  unsigned long   physical byte address
+ */
+
+unsigned long pageMapTranslate(PageMap map, unsigned long address);
+
+/* pageMapPageBits
+ *
+ * @param   map             target map
+ *
+ * @return  int             log2 of the size of the pages mapped
+ */
+
+int pageMapPageBits(PageMap map);
+
+/* pageMapPages
+ *
+ * @param   map             target map
+ *
+ * @return  unsigned long   number of pages mapped so far, counting a
+ *                          page again if it is mapped after its frame
+ *                          was taken back
+ */
+
+unsigned long pageMapPages(PageMap map);
+
+/* pageMapReclaims
+ *
+ * @param   map             target map
+ *
+ * @return  unsigned long   number of frames taken back from an older
+ *                          page because memory was full
+ */
+
+unsigned long pageMapReclaims(PageMap map);
+
+
+#endif
+/* SWIFT_PAGEMAP_H_ */
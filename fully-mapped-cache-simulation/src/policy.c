@@ -0,0 +1,572 @@
+/* File: policy.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Replacement policies for the fully associative cache. See policy.h
+ * for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -Policy
+ *      3. List Helpers
+ *          -listRemove
+ *          -listPushFront
+ *          -listPopBack
+ *      4. TinyLFU Helpers
+ *          -tinyLfuHit
+ *          -tinyLfuFill
+ *          -tinyLfuVictim
+ *      5. Policy Functions
+ *          -parsePolicy
+ *          -policyName
+ *          -createPolicy
+ *          -destroyPolicy
+ *          -policyHit
+ *          -policyHitRun
+ *          -policyFill
+ *          -policyVictim
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "policy.h"
+#include "freqlist.h"
+#include "sketch.h"
+
+/* TinyLFU Segments */
+#define WINDOW 0
+#define PROBATION 1
+#define PROTECTED 2
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* Policy
+ *
+ * Recency ordered policies keep their lines in doubly linked lists
+ * threaded through the prev and next arrays. LRU uses list 0 only;
+ * TinyLFU uses one list per segment. Heads are the most recently used
+ * end of each list.
+ *
+ * @param   type            POLICY_ constant
+ * @param   numLines        number of lines in the cache
+ * @param   prev            previous line in the same list
+ * @param   next            next line in the same list
+ * @param   segment         TinyLFU segment holding each line
+ * @param   head            most recently used line of each list
+ * @param   tail            least recently used line of each list
+ * @param   size            number of lines in each list
+ * @param   limit           TinyLFU target size of each segment
+ * @param   hand            next FIFO victim
+ * @param   seed            random number state
+ * @param   freq            LFU frequency buckets
+ * @param   sketch          TinyLFU admission sketch
+ * @param   source          gives the tag held in a line
+ * @param   context         passed to source
+ * @param   referenced      clock reference bit of each line
+ */
+
+struct Policy_ {
+    int type;
+    int numLines;
+    int* prev;
+    int* next;
+    int* segment;
+    int head[3];
+    int tail[3];
+    int size[3];
+    int limit[3];
+    int hand;
+    unsigned long seed;
+    FreqList freq;
+    Sketch sketch;
+    TagSource source;
+    const void* context;
+    unsigned char* referenced;
+};
+
+/********************************
+ *        3. List Helpers       *
+ ********************************/
+
+/* listRemove
+ *
+ * Unlinks line from list.
+ */
+
+static void listRemove(Policy policy, int list, int line)
+{
+    int prev, next;
+
+    prev = policy->prev[line];
+    next = policy->next[line];
+
+    if(prev == -1)
+    {
+        policy->head[list] = next;
+    }
+    else
+    {
+        policy->next[prev] = next;
+    }
+
+    if(next == -1)
+    {
+        policy->tail[list] = prev;
+    }
+    else
+    {
+        policy->prev[next] = prev;
+    }
+
+    policy->size[list]--;
+}
+
+/* listPushFront
+ *
+ * Links line in at the most recently used end of list.
+ */
+
+static void listPushFront(Policy policy, int list, int line)
+{
+    int head;
+
+    head = policy->head[list];
+
+    policy->prev[line] = -1;
+    policy->next[line] = head;
+
+    if(head == -1)
+    {
+        policy->tail[list] = line;
+    }
+    else
+    {
+        policy->prev[head] = line;
+    }
+
+    policy->head[list] = line;
+    policy->size[list]++;
+}
+
+/* listPopBack
+ *
+ * Unlinks and returns the least recently used line of list, or -1 if
+ * the list is empty.
+ */
+
+static int listPopBack(Policy policy, int list)
+{
+    int line;
+
+    line = policy->tail[list];
+
+    if(line != -1)
+    {
+        listRemove(policy, list, line);
+    }
+
+    return line;
+}
+
+/********************************
+ *      4. TinyLFU Helpers      *
+ ********************************/
+
+/* tinyLfuHit
+ *
+ * Window and protected hits move to the front of their segment. A
+ * probation hit is promoted to protected, which may push the protected
+ * segment's least recently used line back down to probation.
+ */
+
+static void tinyLfuHit(Policy policy, int line, unsigned long tag)
+{
+    int segment, demoted;
+
+    sketchIncrement(policy->sketch, tag);
+
+    segment = policy->segment[line];
+    listRemove(policy, segment, line);
+
+    if(segment == PROBATION)
+    {
+        segment = PROTECTED;
+        policy->segment[line] = PROTECTED;
+    }
+
+    listPushFront(policy, segment, line);
+
+    if(policy->size[PROTECTED] > policy->limit[PROTECTED])
+    {
+        demoted = listPopBack(policy, PROTECTED);
+        policy->segment[demoted] = PROBATION;
+        listPushFront(policy, PROBATION, demoted);
+    }
+}
+
+/* tinyLfuFill
+ *
+ * New blocks always enter the window. While the cache is still filling
+ * up, a window that grows past its limit simply hands its oldest line
+ * to probation.
+ */
+
+static void tinyLfuFill(Policy policy, int line, unsigned long tag)
+{
+    int moved;
+
+    sketchIncrement(policy->sketch, tag);
+
+    policy->segment[line] = WINDOW;
+    listPushFront(policy, WINDOW, line);
+
+    if(policy->size[WINDOW] > policy->limit[WINDOW])
+    {
+        moved = listPopBack(policy, WINDOW);
+        policy->segment[moved] = PROBATION;
+        listPushFront(policy, PROBATION, moved);
+    }
+}
+
+/* tinyLfuVictim
+ *
+ * The window's oldest line is the candidate and the main cache's oldest
+ * probation line (or protected line, if probation is empty) is the
+ * victim. Whichever the sketch has seen less often recently is evicted;
+ * a winning candidate moves into probation.
+ */
+
+static int tinyLfuVictim(Policy policy)
+{
+    int candidate, victim, mainList;
+
+    candidate = policy->tail[WINDOW];
+    mainList = (policy->tail[PROBATION] != -1) ? PROBATION : PROTECTED;
+    victim = policy->tail[mainList];
+
+    if(candidate == -1)
+    {
+        return listPopBack(policy, mainList);
+    }
+
+    listRemove(policy, WINDOW, candidate);
+
+    if(victim == -1)
+    {
+        return candidate;
+    }
+
+    if(sketchEstimate(policy->sketch, policy->source(policy->context, candidate)) >
+       sketchEstimate(policy->sketch, policy->source(policy->context, victim)))
+    {
+        listRemove(policy, mainList, victim);
+        policy->segment[candidate] = PROBATION;
+        listPushFront(policy, PROBATION, candidate);
+        return victim;
+    }
+
+    return candidate;
+}
+
+/********************************
+ *     5. Policy Functions      *
+ ********************************/
+
+/* parsePolicy
+ * ...
+ */
+
+int parsePolicy(const char* name)
+{
+    int type;
+
+    for(type = POLICY_LRU; type <= POLICY_CLOCK; type++)
+    {
+        if(strcmp(name, policyName(type)) == 0)
+        {
+            return type;
+        }
+    }
+
+    return -1;
+}
+
+/* policyName
+ * ...
+ */
+
+const char* policyName(int type)
+{
+    switch(type)
+    {
+        case POLICY_LRU:        return "lru";
+        case POLICY_FIFO:       return "fifo";
+        case POLICY_RANDOM:     return "random";
+        case POLICY_LFU:        return "lfu";
+        case POLICY_TINYLFU:    return "tinylfu";
+        case POLICY_CLOCK:      return "clock";
+        default:                return "unknown";
+    }
+}
+
+/* createPolicy
+ * ...
+ */
+
+Policy createPolicy(int type, int numLines, TagSource source, const void* context)
+{
+    Policy policy;
+    int i, mainList;
+
+    /* Validate Inputs */
+    if(type < POLICY_LRU || type > POLICY_CLOCK || numLines <= 0 || source == NULL)
+    {
+        fprintf(stderr, "Invalid replacement policy parameters.\n");
+        return NULL;
+    }
+
+    policy = (Policy)malloc(sizeof(struct Policy_));
+    assert(policy != NULL);
+
+    policy->type = type;
+    policy->numLines = numLines;
+    policy->prev = NULL;
+    policy->next = NULL;
+    policy->segment = NULL;
+    policy->hand = 0;
+    policy->seed = 0x2545F4914F6CDD1DUL;
+    policy->freq = NULL;
+    policy->sketch = NULL;
+    policy->source = source;
+    policy->context = context;
+    policy->referenced = NULL;
+
+    for(i = 0; i < 3; i++)
+    {
+        policy->head[i] = -1;
+        policy->tail[i] = -1;
+        policy->size[i] = 0;
+        policy->limit[i] = numLines;
+    }
+
+    if(type == POLICY_LRU || type == POLICY_TINYLFU)
+    {
+        policy->prev = (int*)malloc(sizeof(int) * numLines);
+        policy->next = (int*)malloc(sizeof(int) * numLines);
+        assert(policy->prev != NULL && policy->next != NULL);
+    }
+
+    if(type == POLICY_LFU)
+    {
+        policy->freq = createFreqList(numLines);
+    }
+
+    if(type == POLICY_TINYLFU)
+    {
+        policy->segment = (int*)malloc(sizeof(int) * numLines);
+        assert(policy->segment != NULL);
+
+        policy->sketch = createSketch(numLines);
+
+        /* 1% window, and 80% of the rest protected */
+        policy->limit[WINDOW] = (numLines / 100 > 1) ? numLines / 100 : 1;
+        mainList = numLines - policy->limit[WINDOW];
+        policy->limit[PROTECTED] = mainList * 4 / 5;
+        policy->limit[PROBATION] = mainList - policy->limit[PROTECTED];
+    }
+
+    if(type == POLICY_CLOCK)
+    {
+        policy->referenced = (unsigned char*)calloc((unsigned long)numLines / 8 + 1, 1);
+        assert(policy->referenced != NULL);
+    }
+
+    return policy;
+}
+
+/* destroyPolicy
+ * ...
+ */
+
+void destroyPolicy(Policy policy)
+{
+    if(policy != NULL)
+    {
+        free(policy->prev);
+        free(policy->next);
+        free(policy->segment);
+        free(policy->referenced);
+        destroyFreqList(policy->freq);
+        destroySketch(policy->sketch);
+        free(policy);
+    }
+}
+
+/* policyHit
+ * ...
+ */
+
+void policyHit(Policy policy, int line, unsigned long tag)
+{
+    switch(policy->type)
+    {
+        case POLICY_LRU:
+            if(policy->head[0] != line)
+            {
+                listRemove(policy, 0, line);
+                listPushFront(policy, 0, line);
+            }
+            break;
+
+        case POLICY_LFU:
+            freqListAdd(policy->freq, line, 1);
+            break;
+
+        case POLICY_TINYLFU:
+            tinyLfuHit(policy, line, tag);
+            break;
+
+        case POLICY_CLOCK:
+            policy->referenced[line >> 3] |= (unsigned char)(1 << (line & 7));
+            break;
+
+        default:
+            /* FIFO and random ignore hits */
+            break;
+    }
+}
+
+/* policyHitRun
+ * ...
+ */
+
+void policyHitRun(Policy policy, int line, unsigned long tag, unsigned long n)
+{
+    unsigned long i;
+
+    if(n == 0)
+    {
+        return;
+    }
+
+    switch(policy->type)
+    {
+        case POLICY_LFU:
+            freqListAdd(policy->freq, line, n);
+            break;
+
+        case POLICY_TINYLFU:
+            /* Only the first hit moves the line. Every hit counts in the
+               sketch until the tag's counters saturate; from then on the
+               remaining increments would change nothing, since only a
+               change can trigger the halving that would unsaturate them. */
+            tinyLfuHit(policy, line, tag);
+            for(i = 1; i < n; i++)
+            {
+                if(!sketchIncrement(policy->sketch, tag))
+                {
+                    break;
+                }
+            }
+            break;
+
+        default:
+            /* A repeated hit on the most recently used line is a no-op */
+            policyHit(policy, line, tag);
+            break;
+    }
+}
+
+/* policyFill
+ * ...
+ */
+
+void policyFill(Policy policy, int line, unsigned long tag)
+{
+    switch(policy->type)
+    {
+        case POLICY_LRU:
+            listPushFront(policy, 0, line);
+            break;
+
+        case POLICY_LFU:
+            freqListInsert(policy->freq, line, 1);
+            break;
+
+        case POLICY_TINYLFU:
+            tinyLfuFill(policy, line, tag);
+            break;
+
+        case POLICY_CLOCK:
+            policy->referenced[line >> 3] |= (unsigned char)(1 << (line & 7));
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* policyVictim
+ * ...
+ */
+
+int policyVictim(Policy policy)
+{
+    int line;
+
+    switch(policy->type)
+    {
+        case POLICY_LRU:
+            return listPopBack(policy, 0);
+
+        case POLICY_FIFO:
+            /* Free lines are filled in order and a victim is refilled
+               straight away, so the oldest block is always at the hand. */
+            line = policy->hand;
+            policy->hand = (policy->hand + 1) % policy->numLines;
+            return line;
+
+        case POLICY_RANDOM:
+            /* xorshift64 */
+            policy->seed ^= policy->seed << 13;
+            policy->seed ^= policy->seed >> 7;
+            policy->seed ^= policy->seed << 17;
+            return (int)(policy->seed % (unsigned long)policy->numLines);
+
+        case POLICY_LFU:
+            line = freqListMin(policy->freq);
+            freqListRemove(policy->freq, line);
+            return line;
+
+        case POLICY_TINYLFU:
+            return tinyLfuVictim(policy);
+
+        case POLICY_CLOCK:
+            /* Referenced lines get a second chance. Bits are cleared as
+               the hand passes, so it stops within one sweep. */
+            for(;;)
+            {
+                line = policy->hand;
+                policy->hand = (policy->hand + 1) % policy->numLines;
+
+                if(!(policy->referenced[line >> 3] & (1 << (line & 7))))
+                {
+                    return line;
+                }
+
+                policy->referenced[line >> 3] &= (unsigned char)~(1 << (line & 7));
+            }
+
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,154 @@
+/* File: policy.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Replacement policies for the fully associative cache. The cache owns
+ * the lines and the tag index; a policy only tracks the order in which
+ * lines should be given up. The cache calls policyHit on every hit,
+ * policyVictim when it needs a line and every line is in use, and
+ * policyFill once the new block has been placed.
+ *
+ * Policies:
+ *      lru     - least recently used
+ *      fifo    - first in, first out
+ *      random  - uniformly random victim
+ *      lfu     - least frequently used, ties broken by recency. Uses
+ *                frequency buckets so hits and evictions are O(1).
+ *      tinylfu - W-TinyLFU: a 1% LRU window in front of a segmented LRU
+ *                main cache. A block leaving the window only displaces
+ *                the main cache's victim if a count-min sketch says it
+ *                has been seen more often recently.
+ *      clock   - second chance: one reference bit per line and a hand
+ *                that clears set bits until it finds a clear one. An
+ *                LRU approximation at one bit per line, for caches too
+ *                large for the two list links per line LRU keeps.
+ */
+
+#ifndef SWIFT_POLICY_H_
+#define SWIFT_POLICY_H_
+
+#include "tagindex.h"
+
+/* Replacement Policies */
+#define POLICY_LRU 0
+#define POLICY_FIFO 1
+#define POLICY_RANDOM 2
+#define POLICY_LFU 3
+#define POLICY_TINYLFU 4
+#define POLICY_CLOCK 5
+
+/* Typedefs */
+typedef struct Policy_* Policy;
+
+
+/* parsePolicy
+ *
+ * Converts a policy name ("lru", "fifo", ...) into its POLICY_ constant.
+ *
+ * @param   name            policy name
+ *
+ * @return  success         POLICY_ constant
+ * @return  failure         -1
+ */
+
+int parsePolicy(const char* name);
+
+/* policyName
+ *
+ * Returns the name of a POLICY_ constant.
+ *
+ * @param   type            POLICY_ constant
+ *
+ * @return  const char*     policy name
+ */
+
+const char* policyName(int type);
+
+/* createPolicy
+ *
+ * Function to create replacement state for a cache of numLines lines.
+ * TinyLFU compares the blocks of two lines when it evicts and reads
+ * their tags through source rather than keeping a copy, so the tag of a
+ * filled line must stay readable until the line is given up. Returns
+ * the new policy on success and NULL on failure.
+ *
+ * @param   type            POLICY_ constant
+ * @param   numLines        number of lines in the cache
+ * @param   source          gives the tag held in a line
+ * @param   context         passed to source
+ *
+ * @return  success         new Policy
+ * @return  failure         NULL
+ */
+
+Policy createPolicy(int type, int numLines, TagSource source, const void* context);
+
+/* destroyPolicy
+ *
+ * Frees all memory held by the policy. Passing NULL does nothing.
+ *
+ * @param   policy          policy to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyPolicy(Policy policy);
+
+/* policyHit
+ *
+ * Tells the policy that the block in line was accessed again.
+ *
+ * @param   policy          target policy
+ * @param   line            line that hit
+ * @param   tag             tag of the block in that line
+ *
+ * @return  void
+ */
+
+void policyHit(Policy policy, int line, unsigned long tag);
+
+/* policyHitRun
+ *
+ * Same as calling policyHit n times in a row for the same line, in
+ * O(1) for every policy except LFU, which moves up n buckets at once.
+ *
+ * @param   policy          target policy
+ * @param   line            line that hit
+ * @param   tag             tag of the block in that line
+ * @param   n               number of hits
+ *
+ * @return  void
+ */
+
+void policyHitRun(Policy policy, int line, unsigned long tag, unsigned long n);
+
+/* policyFill
+ *
+ * Tells the policy that a new block was placed in line, either a free
+ * line or one just returned by policyVictim.
+ *
+ * @param   policy          target policy
+ * @param   line            line that was filled
+ * @param   tag             tag of the new block
+ *
+ * @return  void
+ */
+
+void policyFill(Policy policy, int line, unsigned long tag);
+
+/* policyVictim
+ *
+ * Picks the line to evict when a miss finds every line in use. The
+ * line is dropped from the policy's bookkeeping; the caller must follow
+ * up with policyFill for the same line.
+ *
+ * @param   policy          target policy
+ *
+ * @return  int             line to evict
+ */
+
+int policyVictim(Policy policy);
+
+
+#endif
+/* SWIFT_POLICY_H_ */
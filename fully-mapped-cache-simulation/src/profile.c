@@ -0,0 +1,273 @@
+/* File: profile.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Hot path instrumentation, built only with "make PROFILE=1". See
+ * profile.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. State
+ *      3. Utility Functions
+ *          -readTicks
+ *          -charge
+ *          -calibrate
+ *      4. Profile Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <assert.h>
+#include <time.h>
+#include "profile.h"
+
+/* Deepest nesting of stages */
+#define PROFILE_DEPTH 8
+
+/* Clock reads used to measure their own cost */
+#define PROFILE_CALIBRATION 1024
+
+/********************************
+ *        2. State              *
+ ********************************/
+
+/* Profile state
+ *
+ * A single run is profiled per process, so the state is global.
+ *
+ * @param   profileActive   1 while the current access is being timed
+ * @param   countdown       accesses until the next timed one
+ * @param   samples         accesses timed
+ * @param   windowStart     clock at the start of the current access
+ * @param   windowTicks     total time of the timed accesses
+ * @param   stageTicks      self time of each stage
+ * @param   stack           stages entered and not yet left
+ * @param   depth           entries in stack
+ * @param   mark            clock at the last stage change
+ * @param   reads           clock reads in the current access
+ * @param   overhead        cost of one clock read
+ */
+
+int profileActive = 0;
+
+static unsigned long countdown = 1;
+static unsigned long samples = 0;
+static unsigned long windowStart = 0;
+static unsigned long windowTicks = 0;
+static unsigned long stageTicks[PROFILE_STAGES];
+static int stack[PROFILE_DEPTH];
+static int depth = 0;
+static unsigned long mark = 0;
+static unsigned long reads = 0;
+static unsigned long overhead = ~0UL;
+
+static const char* stageNames[PROFILE_STAGES] = { "parse", "lookup", "replacement", "stats" };
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* readTicks
+ *
+ * Reads the time stamp counter, or the monotonic clock in nanoseconds
+ * where there is none.
+ */
+
+static unsigned long readTicks(void)
+{
+#if defined(__x86_64__)
+    unsigned int low, high;
+
+    __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+
+    return ((unsigned long)high << 32) | low;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (unsigned long)now.tv_sec * 1000000000UL + (unsigned long)now.tv_nsec;
+#endif
+}
+
+/* charge
+ *
+ * Adds the time since mark, less the cost of reading the clock, to the
+ * stage on top of the stack, and counts the read.
+ */
+
+static void charge(unsigned long now)
+{
+    unsigned long ticks;
+
+    ticks = now - mark;
+    ticks = (ticks > overhead) ? ticks - overhead : 0;
+
+    if(depth > 0)
+    {
+        stageTicks[stack[depth - 1]] += ticks;
+    }
+
+    mark = now;
+    reads++;
+}
+
+/* calibrate
+ *
+ * Takes the smallest of a few back to back clock reads as its cost.
+ */
+
+static void calibrate(void)
+{
+    unsigned long before, after;
+    int i;
+
+    for(i = 0; i < PROFILE_CALIBRATION; i++)
+    {
+        before = readTicks();
+        after = readTicks();
+
+        if(after - before < overhead)
+        {
+            overhead = after - before;
+        }
+    }
+}
+
+/********************************
+ *    4. Profile Functions      *
+ ********************************/
+
+/* profileSample
+ * ...
+ */
+
+void profileSample(void)
+{
+    unsigned long now, window;
+
+    /* The access's own clock reads are not part of it */
+    if(profileActive)
+    {
+        now = readTicks();
+        charge(now);
+        window = now - windowStart;
+        windowTicks += (window > reads * overhead) ? window - reads * overhead : 0;
+        samples++;
+        depth = 0;
+        profileActive = 0;
+    }
+
+    if(--countdown == 0)
+    {
+        if(overhead == ~0UL)
+        {
+            calibrate();
+        }
+
+        countdown = PROFILE_EVERY;
+        profileActive = 1;
+        windowStart = readTicks();
+        mark = windowStart;
+        reads = 0;
+    }
+}
+
+/* profileBegin
+ * ...
+ */
+
+void profileBegin(int stage)
+{
+    assert(depth < PROFILE_DEPTH);
+
+    charge(readTicks());
+    stack[depth++] = stage;
+}
+
+/* profileEnd
+ * ...
+ */
+
+void profileEnd(int stage)
+{
+    assert(depth > 0 && stack[depth - 1] == stage);
+
+    charge(readTicks());
+    depth--;
+}
+
+/* printProfile
+ * ...
+ */
+
+void printProfile(void)
+{
+    unsigned long staged, ticks;
+    int stage;
+
+    staged = 0;
+    for(stage = 0; stage < PROFILE_STAGES; stage++)
+    {
+        staged += stageTicks[stage];
+    }
+
+#if defined(__x86_64__)
+    printf("PROFILE: %lu ACCESSES TIMED (1 IN %d), TSC TICKS\n", samples, PROFILE_EVERY);
+#else
+    printf("PROFILE: %lu ACCESSES TIMED (1 IN %d), NANOSECONDS\n", samples, PROFILE_EVERY);
+#endif
+
+    /* Whatever no stage took is "other" */
+    for(stage = 0; stage <= PROFILE_STAGES; stage++)
+    {
+        if(stage < PROFILE_STAGES)
+        {
+            ticks = stageTicks[stage];
+        }
+        else
+        {
+            ticks = (windowTicks > staged) ? windowTicks - staged : 0;
+        }
+
+        printf("\t%s: PER ACCESS %.1f SHARE %.3f\n", stage < PROFILE_STAGES ? stageNames[stage] : "other",
+               samples ? (double)ticks / (double)samples : 0.0, windowTicks ? (double)ticks / (double)windowTicks : 0.0);
+    }
+}
+
+/* reportProfile
+ * ...
+ */
+
+void reportProfile(Report report)
+{
+    unsigned long staged;
+    int stage;
+
+    staged = 0;
+    for(stage = 0; stage < PROFILE_STAGES; stage++)
+    {
+        staged += stageTicks[stage];
+    }
+
+    reportBegin(report, "profile");
+    reportInt(report, "samples", samples);
+    reportInt(report, "every", PROFILE_EVERY);
+#if defined(__x86_64__)
+    reportString(report, "unit", "tsc");
+#else
+    reportString(report, "unit", "ns");
+#endif
+    reportInt(report, "ticks", windowTicks);
+    for(stage = 0; stage < PROFILE_STAGES; stage++)
+    {
+        reportInt(report, stageNames[stage], stageTicks[stage]);
+    }
+    reportInt(report, "other", windowTicks > staged ? windowTicks - staged : 0);
+    reportEnd(report);
+}
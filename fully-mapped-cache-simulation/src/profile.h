@@ -0,0 +1,118 @@
+/* File: profile.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Hot path instrumentation. Building with "make PROFILE=1" defines
+ * SIM_PROFILE, and the simulator then times one access in every
+ * PROFILE_EVERY, stage by stage, and prints the breakdown at exit:
+ *
+ *      parse           reading and parsing trace records
+ *      lookup          finding a block's line (the tag index probe)
+ *      replacement     replacement policy updates, victim choice and
+ *                      refilling the line, including the write back
+ *      stats           region, hot block and interval bookkeeping
+ *      other           everything else in the sampled accesses
+ *
+ * Time is read with rdtsc on x86-64, in TSC ticks, and from the
+ * monotonic clock in nanoseconds elsewhere. Stages nest, and each is
+ * charged only the time not spent in a stage inside it. The cost of
+ * reading the clock is measured once and taken off every interval.
+ *
+ * Accesses that are not sampled cost a counter decrement and a test of
+ * profileActive per stage. Without SIM_PROFILE every PROFILE_ macro
+ * expands to nothing and profile.c is not built.
+ */
+
+#ifndef SWIFT_PROFILE_H_
+#define SWIFT_PROFILE_H_
+
+#include "report.h"
+
+/* Stages */
+#define PROFILE_PARSE 0
+#define PROFILE_LOOKUP 1
+#define PROFILE_REPLACE 2
+#define PROFILE_STATS 3
+#define PROFILE_STAGES 4
+
+/* One access in PROFILE_EVERY is timed (make PROFILE_EVERY=n) */
+#ifndef PROFILE_EVERY
+#define PROFILE_EVERY 64
+#endif
+
+#ifdef SIM_PROFILE
+
+/* 1 while the current access is being timed */
+extern int profileActive;
+
+/* profileSample
+ *
+ * Marks the start of the next access, closing the previous one. Every
+ * PROFILE_EVERY calls the access that follows is timed.
+ *
+ * @return  void
+ */
+
+void profileSample(void);
+
+/* profileBegin
+ *
+ * Enters a stage, pausing the stage it is nested in.
+ *
+ * @param   stage           PROFILE_ constant
+ *
+ * @return  void
+ */
+
+void profileBegin(int stage);
+
+/* profileEnd
+ *
+ * Leaves the stage entered last.
+ *
+ * @param   stage           PROFILE_ constant
+ *
+ * @return  void
+ */
+
+void profileEnd(int stage);
+
+/* printProfile
+ *
+ * Prints the time per timed access and the share of each stage.
+ *
+ * @return  void
+ */
+
+void printProfile(void);
+
+/* reportProfile
+ *
+ * Records the same breakdown as a "profile" section of report.
+ *
+ * @param   report          target report
+ *
+ * @return  void
+ */
+
+void reportProfile(Report report);
+
+#define PROFILE_SAMPLE() profileSample()
+#define PROFILE_BEGIN(stage) do { if(profileActive) profileBegin(stage); } while(0)
+#define PROFILE_END(stage) do { if(profileActive) profileEnd(stage); } while(0)
+#define PROFILE_PRINT() printProfile()
+#define PROFILE_REPORT(report) reportProfile(report)
+
+#else
+
+#define PROFILE_SAMPLE() ((void)0)
+#define PROFILE_BEGIN(stage) ((void)0)
+#define PROFILE_END(stage) ((void)0)
+#define PROFILE_PRINT() ((void)0)
+#define PROFILE_REPORT(report) ((void)0)
+
+#endif
+
+
+#endif
+/* SWIFT_PROFILE_H_ */
@@ -0,0 +1,478 @@
+/* File: region.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Memory region attribution. See region.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -RegionTable
+ *      3. Utility Functions
+ *          -addChunk
+ *          -totalMisses
+ *      4. RegionTable Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "region.h"
+#include "trace.h"
+
+/* Most distinct chunks tracked while inferring regions */
+#define REGION_CHUNKS 4096
+
+/* The code cluster runs at least 1 / REGION_CODE_SHARE of the PCs */
+#define REGION_CODE_SHARE 10
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* RegionTable
+ *
+ * Slot count of the counters is "other".
+ *
+ * @param   count           number of regions
+ * @param   lows            first address of each region, ascending
+ * @param   highs           first address past each region
+ * @param   names           name of each region
+ * @param   hits            hits per region
+ * @param   misses          misses per region
+ * @param   writes          memory writes per region
+ */
+
+struct RegionTable_ {
+    int count;
+    unsigned long lows[REGION_MAX];
+    unsigned long highs[REGION_MAX];
+    char names[REGION_MAX + 1][REGION_NAME_LENGTH + 1];
+    unsigned long hits[REGION_MAX + 1];
+    unsigned long misses[REGION_MAX + 1];
+    unsigned long writes[REGION_MAX + 1];
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* addChunk
+ *
+ * Adds chunk to the sorted array chunks of *size entries if it is not
+ * there yet, and returns its slot (-1 once the array is full).
+ * pcCounts moves along with it.
+ */
+
+static int addChunk(unsigned long* chunks, unsigned long* pcCounts, int* size, unsigned long chunk)
+{
+    int low, high, mid;
+
+    low = 0;
+    high = *size;
+    while(low < high)
+    {
+        mid = (low + high) / 2;
+        if(chunks[mid] < chunk)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    if(low < *size && chunks[low] == chunk)
+    {
+        return low;
+    }
+
+    if(*size == REGION_CHUNKS)
+    {
+        return -1;
+    }
+
+    memmove(chunks + low + 1, chunks + low, sizeof(unsigned long) * (*size - low));
+    memmove(pcCounts + low + 1, pcCounts + low, sizeof(unsigned long) * (*size - low));
+    chunks[low] = chunk;
+    pcCounts[low] = 0;
+    (*size)++;
+
+    return low;
+}
+
+/* totalMisses
+ *
+ * Returns the misses of every region, "other" included.
+ */
+
+static unsigned long totalMisses(RegionTable table)
+{
+    unsigned long misses;
+    int i;
+
+    misses = 0;
+    for(i = 0; i <= table->count; i++)
+    {
+        misses += table->misses[i];
+    }
+
+    return misses;
+}
+
+/********************************
+ *  4. RegionTable Functions    *
+ ********************************/
+
+/* createRegionTable
+ * ...
+ */
+
+RegionTable createRegionTable(void)
+{
+    RegionTable table;
+
+    table = (RegionTable)calloc(1, sizeof(struct RegionTable_));
+    assert(table != NULL);
+
+    strcpy(table->names[0], "other");
+
+    return table;
+}
+
+/* destroyRegionTable
+ * ...
+ */
+
+void destroyRegionTable(RegionTable table)
+{
+    free(table);
+}
+
+/* regionTableAdd
+ * ...
+ */
+
+int regionTableAdd(RegionTable table, const char* name, unsigned long low, unsigned long high)
+{
+    int i;
+
+    if(low >= high || table->count == REGION_MAX)
+    {
+        return 0;
+    }
+
+    /* Sorted insert; "other" sits one past the last region */
+    i = table->count;
+    while(i > 0 && table->lows[i - 1] > low)
+    {
+        i--;
+    }
+
+    if((i > 0 && table->highs[i - 1] > low) || (i < table->count && table->lows[i] < high))
+    {
+        return 0;
+    }
+
+    memmove(table->lows + i + 1, table->lows + i, sizeof(unsigned long) * (table->count - i));
+    memmove(table->highs + i + 1, table->highs + i, sizeof(unsigned long) * (table->count - i));
+    memmove(table->names + i + 1, table->names + i, sizeof(table->names[0]) * (table->count + 1 - i));
+
+    table->lows[i] = low;
+    table->highs[i] = high;
+    strncpy(table->names[i], name, REGION_NAME_LENGTH);
+    table->names[i][REGION_NAME_LENGTH] = '\0';
+    table->count++;
+
+    return 1;
+}
+
+/* parseRegion
+ * ...
+ */
+
+int parseRegion(RegionTable table, const char* spec)
+{
+    char name[REGION_NAME_LENGTH + 1];
+    const char* colon;
+    char* end;
+    unsigned long low, high;
+    size_t length;
+
+    colon = strchr(spec, ':');
+    if(colon == NULL || colon == spec)
+    {
+        return 0;
+    }
+
+    length = (size_t)(colon - spec);
+    if(length > REGION_NAME_LENGTH)
+    {
+        length = REGION_NAME_LENGTH;
+    }
+    memcpy(name, spec, length);
+    name[length] = '\0';
+
+    low = strtoul(colon + 1, &end, 16);
+    if(end == colon + 1 || *end != '-')
+    {
+        return 0;
+    }
+
+    spec = end + 1;
+    high = strtoul(spec, &end, 16);
+    if(end == spec || *end != '\0')
+    {
+        return 0;
+    }
+
+    return regionTableAdd(table, name, low, high);
+}
+
+/* inferRegions
+ * ...
+ */
+
+int inferRegions(RegionTable table, const char* path)
+{
+    TraceReader reader;
+    Access access;
+    unsigned long* chunks;
+    unsigned long* pcCounts;
+    unsigned long sampled, first[REGION_MAX], last[REGION_MAX], pcs[REGION_MAX], high, total;
+    int size, slot, clusters, c, code, mmaps;
+    char name[REGION_NAME_LENGTH + 1];
+    struct stat info;
+
+    /* The trace is read again for the simulation */
+    if(strcmp(path, "-") == 0 || stat(path, &info) != 0 || !S_ISREG(info.st_mode))
+    {
+        return 0;
+    }
+
+    reader = openTrace(path);
+    if(reader == NULL)
+    {
+        return 0;
+    }
+
+    chunks = (unsigned long*)malloc(sizeof(unsigned long) * REGION_CHUNKS);
+    pcCounts = (unsigned long*)malloc(sizeof(unsigned long) * REGION_CHUNKS);
+    assert(chunks != NULL && pcCounts != NULL);
+
+    /* The chunks touched by data or code */
+    size = 0;
+    sampled = 0;
+    while(sampled < REGION_SAMPLE && readTrace(reader, &access) == 1)
+    {
+        addChunk(chunks, pcCounts, &size, access.address >> REGION_CHUNK_BITS);
+
+        if(access.pc != 0)
+        {
+            slot = addChunk(chunks, pcCounts, &size, access.pc >> REGION_CHUNK_BITS);
+            if(slot != -1)
+            {
+                pcCounts[slot]++;
+            }
+        }
+        sampled++;
+    }
+    closeTrace(reader);
+
+    /* Clusters of chunks at most REGION_GAP apart */
+    clusters = 0;
+    for(slot = 0; slot < size; slot++)
+    {
+        if(clusters > 0 && chunks[slot] - last[clusters - 1] <= REGION_GAP)
+        {
+            last[clusters - 1] = chunks[slot];
+            pcs[clusters - 1] += pcCounts[slot];
+        }
+        else if(clusters < REGION_MAX)
+        {
+            first[clusters] = chunks[slot];
+            last[clusters] = chunks[slot];
+            pcs[clusters] = pcCounts[slot];
+            clusters++;
+        }
+    }
+
+    free(chunks);
+    free(pcCounts);
+
+    if(clusters == 0)
+    {
+        return 0;
+    }
+
+    /* Stack on top; code and globals in the lowest cluster running a
+       good share of the PCs (the executable, not the loader or the
+       libraries), which usually takes in the brk heap as well */
+    total = 0;
+    for(c = 0; c < clusters; c++)
+    {
+        total += pcs[c];
+    }
+
+    code = -1;
+    for(c = 0; c < clusters - 1 && code == -1; c++)
+    {
+        if(pcs[c] > 0 && pcs[c] * REGION_CODE_SHARE >= total)
+        {
+            code = c;
+        }
+    }
+
+    mmaps = 0;
+    for(c = 0; c < clusters; c++)
+    {
+        if(clusters == 1)
+        {
+            strcpy(name, "data");
+        }
+        else if(c == clusters - 1)
+        {
+            strcpy(name, "stack");
+        }
+        else if(c == code)
+        {
+            strcpy(name, "static");
+        }
+        else
+        {
+            sprintf(name, "mmap%d", ++mmaps);
+        }
+
+        high = (last[c] >= (~0UL >> REGION_CHUNK_BITS)) ? ~0UL : (last[c] + 1) << REGION_CHUNK_BITS;
+        regionTableAdd(table, name, first[c] << REGION_CHUNK_BITS, high);
+    }
+
+    return 1;
+}
+
+/* regionFind
+ * ...
+ */
+
+int regionFind(RegionTable table, unsigned long address)
+{
+    const unsigned long* base;
+    int n, half, i;
+
+    if(table->count == 0)
+    {
+        return 0;
+    }
+
+    /* Last region starting at or below address, without branching on
+       the comparisons */
+    base = table->lows;
+    n = table->count;
+    while(n > 1)
+    {
+        half = n / 2;
+        base = (base[half] <= address) ? base + half : base;
+        n -= half;
+    }
+
+    i = (int)(base - table->lows);
+
+    return (table->lows[i] <= address && address < table->highs[i]) ? i : table->count;
+}
+
+/* regionAccess
+ * ...
+ */
+
+void regionAccess(RegionTable table, unsigned long address, int hit, unsigned long count)
+{
+    int i;
+
+    i = regionFind(table, address);
+
+    if(hit)
+    {
+        table->hits[i] += count;
+    }
+    else
+    {
+        table->misses[i] += count;
+    }
+}
+
+/* regionWrite
+ * ...
+ */
+
+void regionWrite(RegionTable table, unsigned long address)
+{
+    table->writes[regionFind(table, address)]++;
+}
+
+/* printRegions
+ * ...
+ */
+
+void printRegions(RegionTable table)
+{
+    unsigned long misses;
+    int i;
+
+    misses = totalMisses(table);
+
+    printf("REGIONS:\n");
+    for(i = 0; i <= table->count; i++)
+    {
+        if(i == table->count)
+        {
+            if(table->hits[i] + table->misses[i] + table->writes[i] == 0)
+            {
+                break;
+            }
+            printf("\t%s", table->names[i]);
+        }
+        else
+        {
+            printf("\t%s 0x%08lx-0x%08lx", table->names[i], table->lows[i], table->highs[i]);
+        }
+
+        printf(": HITS %lu MISSES %lu MEMORY WRITES %lu MISS SHARE %.3f\n", table->hits[i], table->misses[i],
+               table->writes[i], misses ? (double)table->misses[i] / (double)misses : 0.0);
+    }
+}
+
+/* reportRegions
+ * ...
+ */
+
+void reportRegions(RegionTable table, Report report)
+{
+    unsigned long misses;
+    int i;
+
+    misses = totalMisses(table);
+
+    reportBeginList(report, "regions");
+    for(i = 0; i <= table->count; i++)
+    {
+        reportBegin(report, NULL);
+        reportString(report, "name", table->names[i]);
+        reportAddress(report, "low", i < table->count ? table->lows[i] : 0);
+        reportAddress(report, "high", i < table->count ? table->highs[i] : 0);
+        reportInt(report, "hits", table->hits[i]);
+        reportInt(report, "misses", table->misses[i]);
+        reportInt(report, "memory_writes", table->writes[i]);
+        reportReal(report, "miss_share", misses ? (double)table->misses[i] / (double)misses : 0.0);
+        reportEnd(report);
+    }
+    reportEnd(report);
+}
@@ -0,0 +1,175 @@
+/* File: region.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Memory region attribution. A region table holds named, non-overlapping
+ * address ranges, and a cache given one (cacheSetRegions in sim.h)
+ * counts the hits, misses and memory writes of every block against the
+ * region holding it. Anything outside the ranges is counted as "other".
+ *
+ * Ranges are kept sorted by start address and looked up with a
+ * branchless binary search, a handful of conditional moves per access.
+ *
+ * Ranges can be given by hand ("stack:0xbf000000-0xc0000000") or
+ * inferred from a sample of the trace. The 16MB chunks it touches are
+ * merged into clusters. The highest cluster is taken to be the stack.
+ * The lowest one running a good share of the PCs is taken to be the
+ * executable's code and globals ("static"), which on Linux usually
+ * includes the brk heap just above them. The rest are mmap regions:
+ * shared libraries, large allocations and thread stacks.
+ */
+
+#ifndef SWIFT_REGION_H_
+#define SWIFT_REGION_H_
+
+#include "report.h"
+
+/* Most regions in a table */
+#define REGION_MAX 32
+
+/* Longest region name */
+#define REGION_NAME_LENGTH 16
+
+/* Inference: accesses sampled, chunk size (16MB), and the largest gap
+   in chunks between two chunks of one cluster */
+#define REGION_SAMPLE 1000000
+#define REGION_CHUNK_BITS 24
+#define REGION_GAP 4
+
+/* Typedefs */
+typedef struct RegionTable_* RegionTable;
+
+
+/* createRegionTable
+ *
+ * Function to create a table with no regions. Returns the new table.
+ *
+ * @return  success         new RegionTable
+ */
+
+RegionTable createRegionTable(void);
+
+/* destroyRegionTable
+ *
+ * Frees all memory held by the table. Passing NULL does nothing.
+ *
+ * @param   table           table to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyRegionTable(RegionTable table);
+
+/* regionTableAdd
+ *
+ * Adds the region [low, high). Fails if the range is empty, overlaps
+ * another region or the table is full.
+ *
+ * @param   table           target table
+ * @param   name            region name (truncated to REGION_NAME_LENGTH)
+ * @param   low             first address of the region
+ * @param   high            first address past the region
+ *
+ * @return  success         1
+ * @return  failure         0
+ */
+
+int regionTableAdd(RegionTable table, const char* name, unsigned long low, unsigned long high);
+
+/* parseRegion
+ *
+ * Adds a region given as "name:low-high", with hexadecimal addresses
+ * and high exclusive.
+ *
+ * @param   table           target table
+ * @param   spec            region description
+ *
+ * @return  success         1
+ * @return  failure         0
+ */
+
+int parseRegion(RegionTable table, const char* spec);
+
+/* inferRegions
+ *
+ * Adds regions found in the first REGION_SAMPLE accesses of a trace,
+ * named as described above. The trace must be a file, since it is read
+ * again for the simulation.
+ *
+ * @param   table           target table, empty
+ * @param   path            trace file name
+ *
+ * @return  success         1
+ * @return  failure         0
+ */
+
+int inferRegions(RegionTable table, const char* path);
+
+/* regionFind
+ *
+ * @param   table           target table
+ * @param   address         byte address
+ *
+ * @return  int             region holding address, or the number of
+ *                          regions for "other"
+ */
+
+int regionFind(RegionTable table, unsigned long address);
+
+/* regionAccess
+ *
+ * Counts count accesses to the block at address that all hit or all
+ * missed.
+ *
+ * @param   table           target table
+ * @param   address         byte address of the block
+ * @param   hit             1 = hits, 0 = misses
+ * @param   count           number of accesses
+ *
+ * @return  void
+ */
+
+void regionAccess(RegionTable table, unsigned long address, int hit, unsigned long count);
+
+/* regionWrite
+ *
+ * Counts a memory write (write through store or write back) of the
+ * block at address.
+ *
+ * @param   table           target table
+ * @param   address         byte address of the block
+ *
+ * @return  void
+ */
+
+void regionWrite(RegionTable table, unsigned long address);
+
+/* printRegions
+ *
+ * Prints each region's range and counters, and its share of all
+ * misses.
+ *
+ * @param   table           target table
+ *
+ * @return  void
+ */
+
+void printRegions(RegionTable table);
+
+/* reportRegions
+ *
+ * Records each region's range and counters, and its share of all
+ * misses, as a "regions" list. "other" is always the last entry, with
+ * an empty range.
+ *
+ * @param   table           target table
+ * @param   report          target report
+ *
+ * @return  void
+ */
+
+void reportRegions(RegionTable table, Report report);
+
+
+#endif
+/* SWIFT_REGION_H_ */
@@ -0,0 +1,377 @@
+/* File: remap.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Dense block id remapping. See remap.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -IdTrace
+ *      3. Remap Functions
+ *          -remapTrace
+ *      4. IdTrace Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include "remap.h"
+#include "trace.h"
+#include "tagindex.h"
+
+#define IDTRACE_MAGIC "SIMIDS01"
+
+/* Accesses buffered before each write to the output file */
+#define REMAP_CHUNK 65536
+
+/* Most distinct blocks an id trace can name: ids are stored shifted
+   left by one in 32 bits and the tag index counts lines in an int */
+#define REMAP_MAX_BLOCKS 0x7fffffffUL
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* IdTrace
+ *
+ * @param   blockSize       block size the trace was remapped with
+ * @param   length          number of accesses
+ * @param   distinct        number of distinct blocks
+ * @param   stream          accesses, (id << 1) | write
+ * @param   blocks          block address of each id
+ */
+
+struct IdTrace_ {
+    int blockSize;
+    unsigned long length;
+    unsigned long distinct;
+    uint32_t* stream;
+    uint64_t* blocks;
+};
+
+/********************************
+ *      3. Remap Functions      *
+ ********************************/
+
+/* remapTrace
+ * ...
+ */
+
+int remapTrace(const char* in, const char* out, int block_size)
+{
+    TraceReader reader;
+    FILE* file;
+    TagIndex index;
+    Access access;
+    struct stat info;
+    uint64_t header[3], *blocks, block;
+    uint32_t* chunk;
+    unsigned long length, distinct, capacity, i;
+    int offset_bits, id, status, n, written;
+
+    if(block_size <= 0 || (block_size & (block_size - 1)) != 0)
+    {
+        fprintf(stderr, "Invalid block size.\n");
+        return 0;
+    }
+
+    offset_bits = 0;
+    while((1 << offset_bits) < block_size)
+    {
+        offset_bits++;
+    }
+
+    reader = openTrace(in);
+    if(reader == NULL)
+    {
+        fprintf(stderr, "Error: Could not open file.\n");
+        return 0;
+    }
+
+    traceSplitBlocks(reader, offset_bits);
+
+    file = fopen(out, "wb");
+    if(file == NULL)
+    {
+        fprintf(stderr, "Error: Could not open output file.\n");
+        closeTrace(reader);
+        return 0;
+    }
+
+    /* Header is rewritten with the real counts at the end */
+    header[0] = (uint64_t)block_size;
+    header[1] = 0;
+    header[2] = 0;
+    written = (fwrite(IDTRACE_MAGIC, 1, 8, file) == 8 &&
+               fwrite(header, sizeof(uint64_t), 3, file) == 3);
+
+    capacity = 4096;
+    blocks = (uint64_t*)malloc(sizeof(uint64_t) * capacity);
+    chunk = (uint32_t*)malloc(sizeof(uint32_t) * REMAP_CHUNK);
+    assert(blocks != NULL && chunk != NULL);
+
+    index = createTagIndex((int)capacity);
+    length = 0;
+    distinct = 0;
+    n = 0;
+    status = 0;
+
+    while(written && (status = readTrace(reader, &access)) == 1)
+    {
+        block = access.address >> offset_bits;
+        id = tagIndexFind(index, (unsigned long)block);
+
+        if(id == -1)
+        {
+            if(distinct == REMAP_MAX_BLOCKS)
+            {
+                fprintf(stderr, "Error: Trace has more than %lu distinct blocks.\n", REMAP_MAX_BLOCKS);
+                status = -2;
+                break;
+            }
+
+            /* Keep the index at most half full by rebuilding it from the
+               block table whenever the table has to grow */
+            if(distinct == capacity)
+            {
+                capacity = (capacity > REMAP_MAX_BLOCKS / 2) ? REMAP_MAX_BLOCKS : capacity * 2;
+                blocks = (uint64_t*)realloc(blocks, sizeof(uint64_t) * capacity);
+                assert(blocks != NULL);
+
+                destroyTagIndex(index);
+                index = createTagIndex((int)capacity);
+                for(i = 0; i < distinct; i++)
+                {
+                    tagIndexInsert(index, (unsigned long)blocks[i], (int)i);
+                }
+            }
+
+            id = (int)distinct;
+            blocks[distinct++] = block;
+            tagIndexInsert(index, (unsigned long)block, id);
+        }
+
+        chunk[n++] = ((uint32_t)id << 1) | (uint32_t)access.write;
+        length++;
+
+        if(n == REMAP_CHUNK)
+        {
+            written = (fwrite(chunk, sizeof(uint32_t), n, file) == (size_t)n);
+            n = 0;
+        }
+    }
+
+    if(written && status == 0)
+    {
+        header[1] = (uint64_t)length;
+        header[2] = (uint64_t)distinct;
+        written = (fwrite(chunk, sizeof(uint32_t), n, file) == (size_t)n &&
+                   fwrite(blocks, sizeof(uint64_t), distinct, file) == distinct &&
+                   fseek(file, 8, SEEK_SET) == 0 &&
+                   fwrite(header, sizeof(uint64_t), 3, file) == 3);
+    }
+
+    if(fclose(file) != 0)
+    {
+        written = 0;
+    }
+
+    if(status == -1)
+    {
+        fprintf(stderr, "%lu: ERROR!!!!\n", length);
+    }
+    else if(!written)
+    {
+        fprintf(stderr, "Error: Could not write the id trace.\n");
+    }
+    else if(status == 0)
+    {
+        printf("ACCESSES: %lu\nDISTINCT BLOCKS: %lu\n", length, distinct);
+    }
+
+    /* A failed remap leaves no id trace behind, but a device or pipe
+       given as out is not ours to remove */
+    if((status != 0 || !written) && stat(out, &info) == 0 && S_ISREG(info.st_mode))
+    {
+        remove(out);
+    }
+
+    closeTrace(reader);
+    destroyTagIndex(index);
+    free(blocks);
+    free(chunk);
+
+    return (status == 0 && written);
+}
+
+/********************************
+ *    4. IdTrace Functions      *
+ ********************************/
+
+/* isIdTrace
+ * ...
+ */
+
+int isIdTrace(const char* path)
+{
+    FILE* file;
+    struct stat info;
+    char magic[8];
+    int result;
+
+    /* Peeking at a pipe would eat the start of the trace */
+    if(stat(path, &info) != 0 || !S_ISREG(info.st_mode))
+    {
+        return 0;
+    }
+
+    file = fopen(path, "rb");
+    if(file == NULL)
+    {
+        return 0;
+    }
+
+    result = (fread(magic, 1, 8, file) == 8 && memcmp(magic, IDTRACE_MAGIC, 8) == 0);
+    fclose(file);
+
+    return result;
+}
+
+/* loadIdTrace
+ * ...
+ */
+
+IdTrace loadIdTrace(const char* path)
+{
+    IdTrace trace;
+    FILE* file;
+    char magic[8];
+    uint64_t header[3];
+    unsigned long i;
+
+    file = fopen(path, "rb");
+    if(file == NULL)
+    {
+        return NULL;
+    }
+
+    if(fread(magic, 1, 8, file) != 8 || memcmp(magic, IDTRACE_MAGIC, 8) != 0 ||
+       fread(header, sizeof(uint64_t), 3, file) != 3)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    /* The replay indexes arrays by id and shifts by the block size, so
+       a file from another tool or a damaged one must not get that far */
+    if(header[0] == 0 || header[0] > 0x40000000UL || (header[0] & (header[0] - 1)) != 0 ||
+       header[2] > REMAP_MAX_BLOCKS)
+    {
+        fprintf(stderr, "Error: Invalid id trace header.\n");
+        fclose(file);
+        return NULL;
+    }
+
+    trace = (IdTrace)malloc(sizeof(struct IdTrace_));
+    assert(trace != NULL);
+
+    trace->blockSize = (int)header[0];
+    trace->length = (unsigned long)header[1];
+    trace->distinct = (unsigned long)header[2];
+    trace->stream = (uint32_t*)malloc(sizeof(uint32_t) * (trace->length + 1));
+    trace->blocks = (uint64_t*)malloc(sizeof(uint64_t) * (trace->distinct + 1));
+    assert(trace->stream != NULL && trace->blocks != NULL);
+
+    if(fread(trace->stream, sizeof(uint32_t), trace->length, file) != trace->length ||
+       fread(trace->blocks, sizeof(uint64_t), trace->distinct, file) != trace->distinct)
+    {
+        fprintf(stderr, "Error: Truncated id trace.\n");
+        fclose(file);
+        destroyIdTrace(trace);
+        return NULL;
+    }
+
+    fclose(file);
+
+    for(i = 0; i < trace->length; i++)
+    {
+        if((unsigned long)(trace->stream[i] >> 1) >= trace->distinct)
+        {
+            fprintf(stderr, "Error: Id trace access %lu names block %lu of %lu.\n", i,
+                    (unsigned long)(trace->stream[i] >> 1), trace->distinct);
+            destroyIdTrace(trace);
+            return NULL;
+        }
+    }
+
+    return trace;
+}
+
+/* destroyIdTrace
+ * ...
+ */
+
+void destroyIdTrace(IdTrace trace)
+{
+    if(trace != NULL)
+    {
+        free(trace->stream);
+        free(trace->blocks);
+        free(trace);
+    }
+}
+
+/* idTraceBlockSize
+ * ...
+ */
+
+int idTraceBlockSize(IdTrace trace)
+{
+    return trace->blockSize;
+}
+
+/* idTraceLength
+ * ...
+ */
+
+unsigned long idTraceLength(IdTrace trace)
+{
+    return trace->length;
+}
+
+/* idTraceDistinct
+ * ...
+ */
+
+unsigned long idTraceDistinct(IdTrace trace)
+{
+    return trace->distinct;
+}
+
+/* idTraceStream
+ * ...
+ */
+
+const unsigned int* idTraceStream(IdTrace trace)
+{
+    return (const unsigned int*)trace->stream;
+}
+
+/* idTraceBlock
+ * ...
+ */
+
+unsigned long idTraceBlock(IdTrace trace, unsigned long id)
+{
+    return (unsigned long)trace->blocks[id];
+}
@@ -0,0 +1,132 @@
+/* File: remap.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Dense block id remapping. remapTrace makes one pass over a trace,
+ * numbering every distinct block address 0, 1, 2, ... in order of first
+ * use, and writes the accesses out as a stream of those ids. A cache
+ * replaying an id trace can keep its residency map as a plain array
+ * indexed by id (see cacheUseDenseIds in sim.h), so the inner loop never
+ * hashes. This pays off when the same trace is swept over many times.
+ *
+ * Id trace file layout (native byte order):
+ *
+ *      char[8]         "SIMIDS01"
+ *      uint64          block size in bytes
+ *      uint64          number of accesses (n)
+ *      uint64          number of distinct blocks (d)
+ *      uint32[n]       accesses, (id << 1) | write
+ *      uint64[d]       block address (address / block size) of each id
+ */
+
+#ifndef SWIFT_REMAP_H_
+#define SWIFT_REMAP_H_
+
+/* Typedefs */
+typedef struct IdTrace_* IdTrace;
+
+
+/* remapTrace
+ *
+ * Writes the id trace for a text trace. Prints the number of accesses
+ * and distinct blocks. Returns 1 on success and 0 on failure: a bad
+ * trace, a trace with 2^31 or more distinct blocks, which the 31 bit ids
+ * cannot number, or a failed write. A failed remap removes out.
+ *
+ * @param   in              text trace file name
+ * @param   out             id trace file name
+ * @param   block_size      block size in bytes (a power of two)
+ *
+ * @return  success         1
+ * @return  failure         0
+ */
+
+int remapTrace(const char* in, const char* out, int block_size);
+
+/* isIdTrace
+ *
+ * Returns 1 if path names an id trace, 0 otherwise. Only regular files
+ * are checked, so the start of a pipe is never consumed.
+ *
+ * @param   path            file name
+ *
+ * @return  int             1 = id trace, 0 = anything else
+ */
+
+int isIdTrace(const char* path);
+
+/* loadIdTrace
+ *
+ * Reads a whole id trace into memory. The block size must be a power of
+ * two and every id below the number of distinct blocks, so a damaged
+ * file is rejected rather than replayed. Returns the trace on success
+ * and NULL on failure.
+ *
+ * @param   path            id trace file name
+ *
+ * @return  success         new IdTrace
+ * @return  failure         NULL
+ */
+
+IdTrace loadIdTrace(const char* path);
+
+/* destroyIdTrace
+ *
+ * Frees a loaded id trace. Passing NULL does nothing.
+ *
+ * @param   trace           trace to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyIdTrace(IdTrace trace);
+
+/* idTraceBlockSize
+ *
+ * @param   trace           loaded id trace
+ *
+ * @return  int             block size the trace was remapped with
+ */
+
+int idTraceBlockSize(IdTrace trace);
+
+/* idTraceLength
+ *
+ * @param   trace           loaded id trace
+ *
+ * @return  unsigned long   number of accesses
+ */
+
+unsigned long idTraceLength(IdTrace trace);
+
+/* idTraceDistinct
+ *
+ * @param   trace           loaded id trace
+ *
+ * @return  unsigned long   number of distinct blocks
+ */
+
+unsigned long idTraceDistinct(IdTrace trace);
+
+/* idTraceStream
+ *
+ * @param   trace           loaded id trace
+ *
+ * @return  unsigned int*   idTraceLength entries of (id << 1) | write
+ */
+
+const unsigned int* idTraceStream(IdTrace trace);
+
+/* idTraceBlock
+ *
+ * @param   trace           loaded id trace
+ * @param   id              dense block id
+ *
+ * @return  unsigned long   block address the id stands for
+ */
+
+unsigned long idTraceBlock(IdTrace trace, unsigned long id);
+
+
+#endif
+/* SWIFT_REMAP_H_ */
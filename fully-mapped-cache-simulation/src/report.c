@@ -0,0 +1,438 @@
+/* File: report.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Machine readable results. See report.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -ReportBuffer
+ *          -Report
+ *      3. Utility Functions
+ *          -appendText
+ *          -appendQuoted
+ *          -addKey
+ *          -openLevel
+ *          -addValue
+ *      4. Report Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include "report.h"
+
+/* Longest section name kept for csv column names */
+#define REPORT_NAME_LENGTH 32
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* ReportBuffer
+ *
+ * Growable text.
+ *
+ * @param   data            text, not NUL terminated
+ * @param   length          bytes in use
+ * @param   size            bytes allocated
+ */
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t size;
+} ReportBuffer;
+
+/* Report
+ *
+ * Level 0 is the top of the report; each open section or list adds one.
+ * Json goes straight into body. Csv puts column names in header and
+ * values in body.
+ *
+ * @param   format          REPORT_JSON or REPORT_CSV
+ * @param   body            json text, or the csv values line
+ * @param   header          csv column names line
+ * @param   columns         csv columns so far
+ * @param   depth           current level
+ * @param   items           values and sections recorded at each level
+ * @param   lists           1 for each level that is a list
+ * @param   names           name of each level, for csv column names
+ */
+
+struct Report_ {
+    int format;
+    ReportBuffer body;
+    ReportBuffer header;
+    int columns;
+    int depth;
+    int items[REPORT_DEPTH];
+    int lists[REPORT_DEPTH];
+    char names[REPORT_DEPTH][REPORT_NAME_LENGTH + 1];
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* appendText
+ *
+ * Appends length bytes of text to buffer, growing it as needed.
+ */
+
+static void appendText(ReportBuffer* buffer, const char* text, size_t length)
+{
+    if(buffer->length + length > buffer->size)
+    {
+        while(buffer->length + length > buffer->size)
+        {
+            buffer->size = buffer->size ? buffer->size * 2 : 4096;
+        }
+        buffer->data = (char*)realloc(buffer->data, buffer->size);
+        assert(buffer->data != NULL);
+    }
+
+    memcpy(buffer->data + buffer->length, text, length);
+    buffer->length += length;
+}
+
+/* appendQuoted
+ *
+ * Appends a string as a json string (escaped) or as a csv field (quoted
+ * only if it holds a comma, quote or line break).
+ */
+
+static void appendQuoted(Report report, ReportBuffer* buffer, const char* text)
+{
+    char escape[8];
+
+    if(report->format == REPORT_CSV && strpbrk(text, ",\"\r\n") == NULL)
+    {
+        appendText(buffer, text, strlen(text));
+        return;
+    }
+
+    appendText(buffer, "\"", 1);
+    for(; *text != '\0'; text++)
+    {
+        if(*text == '"')
+        {
+            appendText(buffer, report->format == REPORT_JSON ? "\\\"" : "\"\"", 2);
+        }
+        else if(report->format == REPORT_JSON && *text == '\\')
+        {
+            appendText(buffer, "\\\\", 2);
+        }
+        else if(report->format == REPORT_JSON && (unsigned char)*text < 0x20)
+        {
+            sprintf(escape, "\\u%04x", (unsigned int)(unsigned char)*text);
+            appendText(buffer, escape, strlen(escape));
+        }
+        else
+        {
+            appendText(buffer, text, 1);
+        }
+    }
+    appendText(buffer, "\"", 1);
+}
+
+/* addKey
+ *
+ * Starts a value at the current level: the separator and key in json,
+ * the column name in csv.
+ */
+
+static void addKey(Report report, const char* key)
+{
+    int level;
+
+    if(report->format == REPORT_JSON)
+    {
+        if(report->items[report->depth] > 0)
+        {
+            appendText(&report->body, ",", 1);
+        }
+        appendQuoted(report, &report->body, key);
+        appendText(&report->body, ":", 1);
+    }
+    else
+    {
+        if(report->columns > 0)
+        {
+            appendText(&report->header, ",", 1);
+            appendText(&report->body, ",", 1);
+        }
+
+        for(level = 1; level <= report->depth; level++)
+        {
+            appendText(&report->header, report->names[level], strlen(report->names[level]));
+            appendText(&report->header, ".", 1);
+        }
+        appendText(&report->header, key, strlen(key));
+        report->columns++;
+    }
+
+    report->items[report->depth]++;
+}
+
+/* openLevel
+ *
+ * Opens a section or list. Entries of a list are named by their number.
+ */
+
+static void openLevel(Report report, const char* name, int list)
+{
+    char label[REPORT_NAME_LENGTH + 1];
+    int depth;
+
+    depth = report->depth;
+    assert(depth + 1 < REPORT_DEPTH);
+
+    if(report->lists[depth])
+    {
+        sprintf(label, "%d", report->items[depth] + 1);
+    }
+    else
+    {
+        strncpy(label, name, REPORT_NAME_LENGTH);
+        label[REPORT_NAME_LENGTH] = '\0';
+    }
+
+    if(report->format == REPORT_JSON)
+    {
+        if(report->items[depth] > 0)
+        {
+            appendText(&report->body, ",", 1);
+        }
+        if(!report->lists[depth])
+        {
+            appendQuoted(report, &report->body, label);
+            appendText(&report->body, ":", 1);
+        }
+        appendText(&report->body, list ? "[" : "{", 1);
+    }
+
+    report->items[depth]++;
+    report->depth = depth + 1;
+    report->items[depth + 1] = 0;
+    report->lists[depth + 1] = list;
+    strcpy(report->names[depth + 1], label);
+}
+
+/* addValue
+ *
+ * Records a value whose text needs no quoting.
+ */
+
+static void addValue(Report report, const char* key, const char* text)
+{
+    addKey(report, key);
+    appendText(&report->body, text, strlen(text));
+}
+
+/********************************
+ *     4. Report Functions      *
+ ********************************/
+
+/* parseReportFormat
+ * ...
+ */
+
+int parseReportFormat(const char* name)
+{
+    if(strcmp(name, "text") == 0)
+    {
+        return REPORT_TEXT;
+    }
+    else if(strcmp(name, "json") == 0)
+    {
+        return REPORT_JSON;
+    }
+    else if(strcmp(name, "csv") == 0)
+    {
+        return REPORT_CSV;
+    }
+
+    return -1;
+}
+
+/* createReport
+ * ...
+ */
+
+Report createReport(int format)
+{
+    Report report;
+
+    if(format != REPORT_JSON && format != REPORT_CSV)
+    {
+        fprintf(stderr, "Invalid report format.\n");
+        return NULL;
+    }
+
+    report = (Report)calloc(1, sizeof(struct Report_));
+    assert(report != NULL);
+
+    report->format = format;
+
+    if(format == REPORT_JSON)
+    {
+        appendText(&report->body, "{", 1);
+    }
+    reportInt(report, "schema", REPORT_SCHEMA);
+
+    return report;
+}
+
+/* destroyReport
+ * ...
+ */
+
+void destroyReport(Report report)
+{
+    if(report != NULL)
+    {
+        free(report->body.data);
+        free(report->header.data);
+        free(report);
+    }
+}
+
+/* reportBegin
+ * ...
+ */
+
+void reportBegin(Report report, const char* name)
+{
+    openLevel(report, name, 0);
+}
+
+/* reportBeginList
+ * ...
+ */
+
+void reportBeginList(Report report, const char* name)
+{
+    openLevel(report, name, 1);
+}
+
+/* reportEnd
+ * ...
+ */
+
+void reportEnd(Report report)
+{
+    if(report->depth == 0)
+    {
+        return;
+    }
+
+    if(report->format == REPORT_JSON)
+    {
+        appendText(&report->body, report->lists[report->depth] ? "]" : "}", 1);
+    }
+    report->depth--;
+}
+
+/* reportInt
+ * ...
+ */
+
+void reportInt(Report report, const char* key, unsigned long value)
+{
+    char text[32];
+
+    sprintf(text, "%lu", value);
+    addValue(report, key, text);
+}
+
+/* reportReal
+ * ...
+ */
+
+void reportReal(Report report, const char* key, double value)
+{
+    char text[32];
+
+    sprintf(text, "%.6g", value);
+    addValue(report, key, text);
+}
+
+/* reportString
+ * ...
+ */
+
+void reportString(Report report, const char* key, const char* value)
+{
+    addKey(report, key);
+    appendQuoted(report, &report->body, value);
+}
+
+/* reportAddress
+ * ...
+ */
+
+void reportAddress(Report report, const char* key, unsigned long address)
+{
+    char text[32];
+
+    sprintf(text, "0x%08lx", address);
+    reportString(report, key, text);
+}
+
+/* writeReport
+ * ...
+ */
+
+int writeReport(Report report, FILE* file)
+{
+    ReportBuffer* out;
+
+    while(report->depth > 0)
+    {
+        reportEnd(report);
+    }
+
+    /* One buffer, one write */
+    if(report->format == REPORT_JSON)
+    {
+        out = &report->body;
+        appendText(out, "}\n", 2);
+    }
+    else
+    {
+        out = &report->header;
+        appendText(out, "\n", 1);
+        appendText(out, report->body.data, report->body.length);
+        appendText(out, "\n", 1);
+    }
+
+    if(fwrite(out->data, 1, out->length, file) != out->length || fflush(file) != 0)
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+/* reportClock
+ * ...
+ */
+
+double reportClock(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
@@ -0,0 +1,196 @@
+/* File: report.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Machine readable results. A report collects the configuration and
+ * counters of one run as named values grouped into sections, and writes
+ * them out in one go when the run is done:
+ *
+ *      json        one object per run, sections as nested objects and
+ *                  lists as arrays
+ *      csv         a header line of column names and a line of values,
+ *                  with column names made from the section path and
+ *                  the key ("cache.hits", "regions.2.misses")
+ *
+ * The schema is fixed: a section appears when the feature behind it is
+ * enabled, and always holds the same keys in the same order. The
+ * "schema" value at the top is raised whenever a key is renamed or
+ * removed. Addresses are written as hex strings, since JSON numbers
+ * cannot hold every 64 bit value.
+ *
+ * Everything is kept in memory until writeReport, so a run emits a
+ * single write however many values it records.
+ */
+
+#ifndef SWIFT_REPORT_H_
+#define SWIFT_REPORT_H_
+
+#include <stdio.h>
+
+/* Formats */
+#define REPORT_TEXT 0
+#define REPORT_JSON 1
+#define REPORT_CSV 2
+
+/* Schema version */
+#define REPORT_SCHEMA 1
+
+/* Deepest nesting of sections */
+#define REPORT_DEPTH 8
+
+/* Typedefs */
+typedef struct Report_* Report;
+
+
+/* parseReportFormat
+ *
+ * Maps a format name ("text", "json" or "csv") to its REPORT_ constant.
+ *
+ * @param   name            format name
+ *
+ * @return  success         REPORT_ constant
+ * @return  failure         -1
+ */
+
+int parseReportFormat(const char* name);
+
+/* createReport
+ *
+ * Function to create an empty report holding only the schema version.
+ * Returns the new report on success and NULL on failure (including
+ * REPORT_TEXT, which is printed directly rather than through a report).
+ *
+ * @param   format          REPORT_JSON or REPORT_CSV
+ *
+ * @return  success         new Report
+ * @return  failure         NULL
+ */
+
+Report createReport(int format);
+
+/* destroyReport
+ *
+ * Frees all memory held by the report. Passing NULL does nothing.
+ *
+ * @param   report          report to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyReport(Report report);
+
+/* reportBegin
+ *
+ * Opens a section. Values and sections recorded until the matching
+ * reportEnd go inside it.
+ *
+ * @param   report          target report
+ * @param   name            section name, or NULL for the next entry of
+ *                          a list
+ *
+ * @return  void
+ */
+
+void reportBegin(Report report, const char* name);
+
+/* reportBeginList
+ *
+ * Opens a list, whose entries are sections opened with a NULL name and
+ * numbered from 1 in csv column names.
+ *
+ * @param   report          target report
+ * @param   name            list name
+ *
+ * @return  void
+ */
+
+void reportBeginList(Report report, const char* name);
+
+/* reportEnd
+ *
+ * Closes the section or list opened last.
+ *
+ * @param   report          target report
+ *
+ * @return  void
+ */
+
+void reportEnd(Report report);
+
+/* reportInt
+ *
+ * Records a count.
+ *
+ * @param   report          target report
+ * @param   key             value name
+ * @param   value           value
+ *
+ * @return  void
+ */
+
+void reportInt(Report report, const char* key, unsigned long value);
+
+/* reportReal
+ *
+ * Records a rate or ratio, with six significant digits.
+ *
+ * @param   report          target report
+ * @param   key             value name
+ * @param   value           value
+ *
+ * @return  void
+ */
+
+void reportReal(Report report, const char* key, double value);
+
+/* reportString
+ *
+ * Records a string, quoted as the format needs.
+ *
+ * @param   report          target report
+ * @param   key             value name
+ * @param   value           value
+ *
+ * @return  void
+ */
+
+void reportString(Report report, const char* key, const char* value);
+
+/* reportAddress
+ *
+ * Records an address as a hex string.
+ *
+ * @param   report          target report
+ * @param   key             value name
+ * @param   address         value
+ *
+ * @return  void
+ */
+
+void reportAddress(Report report, const char* key, unsigned long address);
+
+/* writeReport
+ *
+ * Closes any sections still open and writes the report to file.
+ *
+ * @param   report          target report
+ * @param   file            output stream
+ *
+ * @return  success         1
+ * @return  failure         0
+ */
+
+int writeReport(Report report, FILE* file);
+
+/* reportClock
+ *
+ * Returns a monotonic time in seconds, for timing runs.
+ *
+ * @return  double          seconds since an arbitrary start
+ */
+
+double reportClock(void);
+
+
+#endif
+/* SWIFT_REPORT_H_ */
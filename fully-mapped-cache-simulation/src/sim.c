@@ -2,23 +2,27 @@
  *
  * Author: Mike Swift <theycallmeswift@gmail.com>
  * Date Created: April 28th, 2011
- * Date Modified: May 1st, 2011
+ * Date Modified: October 17th, 2026
  * 
  * This is a program that simulates a cache using a trace file 
  * and either a write through or write back policy.
  * 
- * Usage: Usage: ./sim [-h] <write policy> <trace file>
+ * Usage: Usage: ./sim [-h] [options] <write policy> <trace file>
+ *        ./sim object [--policy lru|gdsf] <capacity> <trace file>
+ *        ./sim remap [--block-size <bytes>] <trace file> <id trace file>
+ *        ./sim stats [--approx] <trace file>
+ *        ./sim index [--every <n>] <trace file> [<index file>]
  *
  * <write policy> is one of:
  *      wt - simulate a write through cache.
  *      wb - simulate a write back cache
  *
- * <trace file> is the name of a file that contains a memory access trace.
+ * <trace file> is the name of a file that contains a memory access trace,
+ * or - to read the trace from standard input.
  *
  * Table of Contents:
  *      1. Includes
  *      2. Structs
- *          -Block
  *          -Cache
  *      3. Utility Functions
  *          -htoi
@@ -27,11 +31,28 @@
  *          -btoi
  *          -parseMemoryAddress
  *      4. Main Function
+ *          -printUsage
+ *          -objectMain
+ *          -indexMain
+ *          -indexPath
+ *          -printCounters
+ *          -printInterval
+ *          -reportCounters
+ *          -reportRun
+ *          -parseSize
+ *          -parseBytes
+ *          -remapMain
+ *          -translateAccess
+ *          -accessPhysical
+ *          -simulateFetch
+ *          -runIdTrace
+ *          -main
  *      5. Cache Functions
  *          -createCache
  *          -destroyCache
  *          -readFromCache
  *          -writeToCache
+ *          -accessCache
  *          -printCache
  */
  
@@ -44,51 +65,91 @@
 #include <assert.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
 #include "sim.h"
+#include "policy.h"
+#include "tagindex.h"
+#include "linestore.h"
+#include "objcache.h"
+#include "trace.h"
+#include "traceindex.h"
+#include "remap.h"
+#include "stats.h"
+#include "tracewriter.h"
+#include "tlb.h"
+#include "pagemap.h"
+#include "report.h"
+#include "profile.h"
 
 /********************************
  *        2. Structs            *
  ********************************/
 
-/* Block
- *
- * Holds an integer that states the validity of the bit (0 = invalid,
- * 1 = valid), the tag being held, and another integer that states if
- * the bit is dirty or not (0 = clean, 1 = dirty).
- */
-
-struct Block_ {
-    int valid;
-    char* tag;
-    int dirty;
-};
-
 /* Cache
  *
  * Cache object that holds all the data about cache access as well as 
- * the write policy, sizes, and an array of blocks.
+ * the write policy, sizes, and the state of every line.
  *
  * @param   hits            # of cache accesses that hit valid data
  * @param   misses          # of cache accesses that missed valid data
  * @param   reads           # of reads from main memory
  * @param   writes          # of writes from main memory
+ * @param   splits          # of accesses that touched more than one block
+ * @param   cycles          cycles spent on accesses (hit latency for
+ *                          each, plus memory latency for each fill)
+ * @param   hitLatency      cycles per access
+ * @param   memoryLatency   extra cycles per fill from memory
+ * @param   mshrs           Miss status holding registers (or NULL)
+ * @param   now             Non-blocking clock, kept when mshrs is set
+ * @param   dram            DRAM behind the cache (or NULL)
+ * @param   regions         Per region counters (or NULL)
+ * @param   hotMisses       Misses per block address (or NULL)
+ * @param   hotWrites       Memory writes per block address (or NULL)
  * @param   cache_size      Total size of the cache in bytes
  * @param   block_size      How big each block of data should be
+ * @param   offset_bits     log2(block_size)
  * @param   numLines        Total number of blocks
- * @param   blocks          The actual array of blocks  
+ * @param   used            # of lines filled so far (lines fill in order,
+ *                          so a line is valid if it is below used)
+ * @param   write_policy    0 = write through, 1 = write back
+ * @param   lines           Tag and dirty bit of each line
+ * @param   index           Maps the tag of each valid block to its line
+ * @param   bloom           Rules out misses before the index (or NULL)
+ * @param   lineOf          Dense id mode: line holding each id (-1 = none)
+ * @param   policy          Replacement policy state
+ * @param   pc              PC of the access being simulated
+ * @param   filter          Receives the miss/writeback stream (or NULL)
  */
 
 
 struct Cache_ {
-    int hits;
-    int misses;
-    int reads;
-    int writes;
-    int cache_size;
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long reads;
+    unsigned long writes;
+    unsigned long splits;
+    unsigned long cycles;
+    unsigned long hitLatency;
+    unsigned long memoryLatency;
+    MshrFile mshrs;
+    unsigned long now;
+    Dram dram;
+    RegionTable regions;
+    TopK hotMisses;
+    TopK hotWrites;
+    long cache_size;
     int block_size;
+    int offset_bits;
     int numLines;
+    int used;
     int write_policy;
-    Block* blocks;    
+    LineStore lines;
+    TagIndex index;
+    BloomFilter bloom;
+    int* lineOf;
+    Policy policy;
+    unsigned long pc;
+    TraceWriter filter;
 };
 
 
@@ -331,380 +392,2421 @@ void parseMemoryAddress(char *address)
  *        4. Main Function      *
  ********************************/
  
-/*
- * Algorithm:
- *  1. Validate inputs
- *  2. Open the trace file for reading
- *  3. Create a new cache object
- *  4. Read a line from the file
- *  5. Parse the line and read or write accordingly
- *  6. If the line is "#eof" continue, otherwise go back to step 4 
- *  7. Print the results
- *  8. Destroy the cache object
- *  9. Close the file
+/* printUsage
+ *
+ * Prints the help menu, one line of the usage table at a time.
  */
 
-int main(int argc, char **argv)
+static void printUsage(void)
 {
-    /* Local Variables */
-    int write_policy, counter, i, j;
-    Cache cache;
-    FILE *file;
-    char mode, address[100];
-    
-    /* Technically a line shouldn't be longer than 25 characters, but
-       allocate extra space in the buffer just in case */
-    char buffer[LINELENGTH];
-    
-    /* Help Menu
-     *
-     * If the help flag is present or there are fewer than
-     * three arguments, print the usage menu and return. 
-     */
-     
-    if(argc < 3 || strcmp(argv[1], "-h") == 0)
+    static const char *usage[] = {
+        "Usage: ./sim [-h] [options] <write policy> <trace file>",
+        "",
+        "<write policy> is one of: ",
+        "\twt - simulate a write through cache. ",
+        "\twb - simulate a write back cache ",
+        "",
+        "<trace file> is the name of a file that contains a memory access trace.",
+        "<trace file> may be - for standard input, or a named pipe.",
+        "",
+        "[options] are:",
+        "\t--policy <name> - replacement policy: lru (default), fifo, random, lfu, tinylfu, clock",
+        "\t--cache-size <bytes> - data cache size (default 16384, up to 1024G)",
+        "\t--block-size <bytes> - data cache block size (default 4)",
+        "\t--icache <bytes> - model a separate instruction cache of this size",
+        "\t--icache-block <bytes> - instruction cache block size (default the data block size)",
+        "\t--unified - send instruction fetches to the data cache",
+        "\t--hit-latency <cycles> - cycles per cache access (default 1)",
+        "\t--icache-latency <cycles> - cycles per instruction cache access (default the hit latency)",
+        "\t--memory-latency <cycles> - extra cycles per miss (default 100)",
+        "\t--mshrs <n> - time the data cache as non-blocking with n miss status holding registers",
+        "\t--dram - put a DRAM model behind the data cache",
+        "\t--dram-channels <n> - DRAM channels (default 1)",
+        "\t--dram-banks <n> - DRAM banks per channel (default 8)",
+        "\t--dram-row <bytes> - DRAM row size (default 8192)",
+        "\t--dram-page open|closed - DRAM page policy (default open)",
+        "\t--tlb - model a DTLB and STLB in front of the data cache",
+        "\t--dtlb <entries> - DTLB entries (default 64)",
+        "\t--stlb <entries> - STLB entries, 0 for none (default 1536)",
+        "\t--page-size <bytes> - page size for --tlb and --translate, e.g. 4K, 2M or 1G (default 4K)",
+        "\t--page-walk - send page walk reads through the data cache",
+        "\t--translate <allocator> - send physical addresses to the caches: identity, random, color or huge",
+        "\t--phys-mem <bytes> - physical memory for --translate (default 4G)",
+        "\t--colors <n> - page colors for --translate color (default 64)",
+        "\t--regions - report hits, misses and memory writes per address region, inferred from the trace",
+        "\t--region <name:low-high> - add a region by hand, in hex (repeatable)",
+        "\t--hot <k> - report the k blocks with the most misses and the most memory writes",
+        "\t--hot-counters <n> - counters for --hot, bounding its memory (default 4096)",
+        "\t--hot-exact - count every block exactly for --hot",
+        "\t--bloom - check a counting Bloom filter before the tag index, skipping the probe on certain misses",
+        "\t--bloom-counters <n> - Bloom filter counters per cache line (default 8)",
+        "\t--compact - index tags by fingerprint to fit very large caches in memory",
+        "\t--core - model an in-order core that stalls on every access beyond a hit",
+        "\t--collapse - apply runs of accesses to the same block in one step",
+        "\t--start <k> - start at access k, seeking through <trace file>.idx if present",
+        "\t--count <n> - simulate at most n accesses",
+        "\t--interval <n> - print the counters every n accesses",
+        "\t--filter <file> - write the miss and writeback stream to file as a trace",
+        "\t--filter-format text|binary - format of the filtered trace (default text)",
+        "\t--format text|json|csv - print the results as text (default), or as one JSON object or CSV row",
+        "",
+        "Object cache mode: ./sim object [--policy lru|gdsf] <capacity> <trace file>",
+        "Dense id remapping: ./sim remap [--block-size <bytes>] <trace file> <id trace file>",
+        "Trace statistics: ./sim stats [--approx] <trace file>",
+        "Trace index: ./sim index [--every <n>] <trace file> [<index file>]",
+        NULL
+    };
+    int i;
+
+    for(i = 0; usage[i] != NULL; i++)
     {
-        fprintf(stderr, 
-        "Usage: ./sim [-h] <write policy> <trace file>\n\n<write policy> is one of: \n\twt - simulate a write through cache. \n\twb - simulate a write back cache \n\n<trace file> is the name of a file that contains a memory access trace.\n");
-        return 0;
+        fprintf(stderr, "%s\n", usage[i]);
     }
-    
-    /* Write Policy */
-    if(strcmp(argv[1], "wt") == 0)
+}
+
+/* objectMain
+ *
+ * Runs the object cache mode: ./sim object [--policy lru|gdsf]
+ * <capacity> <trace file>. Each trace line holds an object id (decimal
+ * or 0x hex) and its size in bytes; the cache holds at most capacity
+ * bytes. See objcache.h.
+ */
+
+static int objectMain(int argc, char **argv)
+{
+    int policy, arg;
+    unsigned long capacity, id, size, line;
+    ObjectCache cache;
+    FILE *file;
+    char buffer[LINELENGTH], *end, *start;
+
+    policy = OBJECT_LRU;
+    arg = 2;
+
+    if(arg + 1 < argc && strcmp(argv[arg], "--policy") == 0)
     {
-        write_policy = 0;
-        if(DEBUG) printf("Write Policy: Write Through\n");
+        policy = parseObjectPolicy(argv[arg + 1]);
+        if(policy == -1)
+        {
+            fprintf(stderr, "Invalid Object Policy: %s\n", argv[arg + 1]);
+            return 0;
+        }
+        arg = arg + 2;
     }
-    else if(strcmp(argv[1], "wb") == 0)
+
+    if(arg != argc - 2)
     {
-        write_policy = 1;
-        if(DEBUG) printf("Write Policy: Write Back\n");
+        fprintf(stderr, "Usage: ./sim object [--policy lru|gdsf] <capacity> <trace file>\n");
+        return 0;
     }
-    else
+
+    capacity = strtoul(argv[arg], &end, 10);
+    if(*end != '\0' || capacity == 0)
     {
-        fprintf(stderr, "Invalid Write Policy.\nUsage: ./sim [-h] <write policy> <trace file>\n");
+        fprintf(stderr, "Invalid Capacity: %s\n", argv[arg]);
         return 0;
     }
-    
-    /* Open the file for reading. */
-    file = fopen( argv[2], "r" );
-    if( file == NULL )
+
+    file = fopen(argv[arg + 1], "r");
+    if(file == NULL)
     {
         fprintf(stderr, "Error: Could not open file.\n");
-        return 0; 
+        return 0;
     }
 
-    cache = createCache(CACHE_SIZE, BLOCK_SIZE, write_policy);
-    
-    counter = 0;
-    
-    while( fgets(buffer, LINELENGTH, file) != NULL )
+    cache = createObjectCache(capacity, policy);
+    if(cache == NULL)
+    {
+        fclose(file);
+        return 0;
+    }
+
+    line = 0;
+    while(fgets(buffer, LINELENGTH, file) != NULL)
     {
-        if(buffer[0] != '#')
+        line++;
+
+        if(buffer[0] == '#')
         {
-            i = 0;
-            while(buffer[i] != ' ')
-            {
-                i++;
-            }
-            
-            mode = buffer[i+1];
-            
-            i = i+2;
-            j = 0;
-            
-            while(buffer[i] != '\0')
-            {
-                address[j] = buffer[i];
-                i++;
-                j++;
-            }
-            
-            address[j-1] = '\0';
-            
-            if(DEBUG) printf("%i: %c %s\n", counter, mode, address);
-            
-            if(mode == 'R')
-            {
-                readFromCache(cache, address);
-            }
-            else if(mode == 'W')
-            {
-                writeToCache(cache, address);
-            }
-            else
-            {
-                printf("%i: ERROR!!!!\n", counter);
-                fclose(file);
-                destroyCache(cache);
-                cache = NULL;
-                
-                return 0;
-            }
-            counter++;
+            continue;
+        }
+
+        id = strtoul(buffer, &end, 0);
+        if(end == buffer)
+        {
+            continue;
+        }
+
+        /* Every object needs a size of at least one byte */
+        start = end;
+        size = strtoul(start, &end, 10);
+        if(end == start || size == 0 || (*end != '\0' && !isspace((unsigned char)*end)))
+        {
+            fprintf(stderr, "Error: Invalid object size on line %lu.\n", line);
+            fclose(file);
+            destroyObjectCache(cache);
+            return 0;
         }
+
+        objectCacheAccess(cache, id, size);
     }
-    
-    if(DEBUG) printf("Num Lines: %i\n", counter);
-    
-    printf("CACHE HITS: %i\nCACHE MISSES: %i\nMEMORY READS: %i\nMEMORY WRITES: %i\n", cache->hits, cache->misses, cache->reads, cache->writes);
-    
-    /* Close the file, destroy the cache. */
-    
+
+    printObjectCache(cache);
+
     fclose(file);
-    destroyCache(cache);
+    destroyObjectCache(cache);
     cache = NULL;
-    
+
     return 1;
 }
 
-/********************************
- *     5. Cache Functions       *
- ********************************/
- 
-/* Function List:
+/* indexPath
  *
- * 1) createCache
- * 2) destroyCache
- * 3) readFromCache
- * 4) writeToCache
- * 5) printCache
+ * Returns the default index file name for a trace, "<trace>.idx". The
+ * caller frees it.
  */
 
+static char* indexPath(const char *trace)
+{
+    char *path;
 
-/* createCache
- *
- * Function to create a new cache struct.  Returns the new struct on success
- * and NULL on failure.
- *
- * @param   cache_size      size of cache in bytes
- * @param   block_size      size of each block in bytes
- * @param   write_policy    0 = write through, 1 = write back
+    path = (char*)malloc(strlen(trace) + 5);
+    assert(path != NULL);
+    strcpy(path, trace);
+    strcat(path, ".idx");
+
+    return path;
+}
+
+/* indexMain
  *
- * @return  success         new Cache
- * @return  failure         NULL
+ * Runs ./sim index [--every <n>] <trace file> [<index file>]. The index
+ * file defaults to <trace file>.idx, where the simulator looks for it.
+ * See traceindex.h.
  */
 
-Cache createCache(int cache_size, int block_size, int write_policy)
+static int indexMain(int argc, char **argv)
 {
-    Cache cache;
-    
-    /* Validate Inputs */
-    if (cache_size <= 0 || block_size <= 0 || (write_policy != 0 && write_policy != 1))
+    unsigned long every;
+    int arg, status;
+    char *path, *end;
+
+    every = INDEX_DEFAULT_EVERY;
+    arg = 2;
+
+    if(arg + 1 < argc && strcmp(argv[arg], "--every") == 0)
     {
-        fprintf(stderr, "Invalid cache parameters.\n");
-        return NULL;
+        every = strtoul(argv[arg + 1], &end, 10);
+        if(*end != '\0' || every == 0)
+        {
+            fprintf(stderr, "Invalid Chunk Size: %s\n", argv[arg + 1]);
+            return 0;
+        }
+        arg = arg + 2;
     }
 
-    /* Create Cache */
-    cache = (Cache)malloc(sizeof(struct Cache_));
-    assert(cache != NULL);
-
-    cache->hits = 0;
-    cache->misses = 0;
-    cache->reads = 0;
-    cache->writes = 0;
+    if(arg != argc - 1 && arg != argc - 2)
+    {
+        fprintf(stderr, "Usage: ./sim index [--every <n>] <trace file> [<index file>]\n");
+        return 0;
+    }
 
-    cache->write_policy = write_policy;
+    if(arg == argc - 2)
+    {
+        return indexTrace(argv[arg], argv[arg + 1], every);
+    }
 
-    cache->cache_size = cache_size;
-    cache->block_size = block_size;
+    path = indexPath(argv[arg]);
+    status = indexTrace(argv[arg], path, every);
+    free(path);
 
-    /* Allocate array of block pointers */
-    cache->blocks = (Block**)malloc(sizeof(Block*) * cache_size / block_size);
-    assert(cache->blocks != NULL);
+    return status;
+}
 
-    /* Initialize each block pointer to NULL */
-    for (int i = 0; i < cache_size / block_size; i++)
-    {
-        cache->blocks[i] = NULL;
-    }
+/* printCounters
+ *
+ * Prints the end of run counters for a cache.
+ */
 
-    return cache;
+static void printCounters(Cache cache)
+{
+    printf("CACHE HITS: %lu\nCACHE MISSES: %lu\nMEMORY READS: %lu\nMEMORY WRITES: %lu\n", cache->hits, cache->misses, cache->reads, cache->writes);
 }
 
-/* destroyCache
- * ...
+/* printInterval
+ *
+ * Prints the counters so far on one line, with the hit rate since the
+ * previous report, and flushes so a reader at the end of a pipe sees
+ * it straight away. last holds the hits and accesses at the previous
+ * report and is updated. With a report, the counters go into it as the
+ * next entry of its "intervals" list instead.
  */
 
-void destroyCache(Cache cache)
+static void printInterval(Cache cache, unsigned long accesses, unsigned long last[2], Report report)
 {
-    if (cache != NULL)
+    unsigned long hits;
+
+    hits = cache->hits - last[0];
+
+    if(report != NULL)
     {
-        for (int i = 0; i < cache->cache_size / cache->block_size; i++)
-        {
-            if (cache->blocks[i] != NULL)
-            {
-                free(cache->blocks[i]->tag);
-                free(cache->blocks[i]);
-            }
-        }
-        free(cache->blocks);
-        free(cache);
+        reportBegin(report, NULL);
+        reportInt(report, "accesses", accesses);
+        reportInt(report, "hits", cache->hits);
+        reportInt(report, "misses", cache->misses);
+        reportInt(report, "memory_reads", cache->reads);
+        reportInt(report, "memory_writes", cache->writes);
+        reportReal(report, "hit_rate", (accesses > last[1]) ? (double)hits / (double)(accesses - last[1]) : 0.0);
+        reportEnd(report);
     }
+    else
+    {
+        printf("INTERVAL: ACCESSES %lu HITS %lu MISSES %lu MEMORY READS %lu MEMORY WRITES %lu HIT RATE %.4f\n",
+               accesses, cache->hits, cache->misses, cache->reads, cache->writes,
+               (accesses > last[1]) ? (double)hits / (double)(accesses - last[1]) : 0.0);
+        fflush(stdout);
+    }
+
+    last[0] = cache->hits;
+    last[1] = accesses;
 }
 
-/* readFromCache
- * ...
+/* reportCounters
+ *
+ * Records the end of run counters for a cache as a section of report,
+ * with the rates and timing derived from them.
  */
 
-int readFromCache(Cache cache, char* address)
+static void reportCounters(Report report, const char *name, Cache cache)
 {
-    unsigned int dec,i;
-    char *bstring, *bformatted, *tag;
+    unsigned long accesses;
+
+    accesses = cache->hits + cache->misses;
+
+    reportBegin(report, name);
+    reportInt(report, "hits", cache->hits);
+    reportInt(report, "misses", cache->misses);
+    reportInt(report, "memory_reads", cache->reads);
+    reportInt(report, "memory_writes", cache->writes);
+    reportInt(report, "split_accesses", cache->splits);
+    reportReal(report, "hit_rate", accesses ? (double)cache->hits / (double)accesses : 0.0);
+    reportReal(report, "miss_rate", accesses ? (double)cache->misses / (double)accesses : 0.0);
+    reportInt(report, "access_cycles", cache->cycles);
+    reportReal(report, "amat", accesses ? (double)cache->cycles / (double)accesses : 0.0);
+    reportEnd(report);
+}
 
-    /* Validate inputs */
-    if (cache == NULL || address == NULL)
-    {
-        fprintf(stderr, "Error: Invalid cache or memory address.\n");
-        return 0;
-    }
+/* reportRun
+ *
+ * Records the accesses simulated and the wall clock time taken.
+ */
 
-    /* Convert and parse necessary values */
-    dec = htoi(address);
-    bstring = getBinary(dec);
-    bformatted = formatBinary(bstring);
+static void reportRun(Report report, unsigned long accesses, double seconds)
+{
+    reportBegin(report, "run");
+    reportInt(report, "accesses", accesses);
+    reportReal(report, "seconds", seconds);
+    reportReal(report, "accesses_per_second", seconds > 0.0 ? (double)accesses / seconds : 0.0);
+    reportEnd(report);
+}
 
-    i = 0;
-    
-    tag = (char *)malloc(sizeof(char) * (TAG + 1));
-    assert(tag != NULL);
-    tag[TAG] = '\0';
+/* parseSize
+ *
+ * Parses a positive size in bytes of at most max, optionally followed
+ * by K, M or G (2MB pages are "2M"). Returns -1 if text is not one.
+ */
 
-    for (i = 0; i < TAG; i++)
+static long parseSize(const char *text, long max)
+{
+    char *end;
+    long value;
+
+    value = strtol(text, &end, 10);
+    if(end == text || value <= 0)
     {
-        tag[i] = bformatted[i];
+        return -1;
     }
 
-    for (int i = 0; i < cache->cache_size / cache->block_size; i++)
+    if(*end == 'K' || *end == 'k' || *end == 'M' || *end == 'm' || *end == 'G' || *end == 'g')
     {
-        Block block = cache->blocks[i];
-
-        if (block != NULL && block->valid == 1 && strcmp(block->tag, tag) == 0)
-        {
-            cache->hits++;
-            free(tag);
-            return 1;
-        }
+        value <<= (toupper(*end) == 'K') ? 10 : (toupper(*end) == 'M') ? 20 : 30;
+        end++;
     }
 
-    /* Block not found, allocate memory and add it to the cache */
-    Block newBlock = (Block)malloc(sizeof(struct Block_));
-    assert(newBlock != NULL);
-    newBlock->valid = 1;
-    newBlock->dirty = 0;
-    newBlock->tag = tag;
-
-    /* Find an empty spot in the cache to store the block */
-    for (int i = 0; i < cache->cache_size / cache->block_size; i++)
+    if(*end != '\0' || value > max)
     {
-        if (cache->blocks[i] == NULL)
-        {
-            cache->blocks[i] = newBlock;
-            cache->misses++;
-            cache->reads++;
-            return 1;
-        }
+        return -1;
     }
 
-    /* If no empty spot found, replace a block using a replacement policy (e.g., LRU) */
-    free(newBlock->tag);
-    free(newBlock);
+    return value;
+}
 
-    return 0;
+/* parseBytes
+ *
+ * parseSize for the sizes kept in an int, up to 1GB.
+ */
+
+static int parseBytes(const char *text)
+{
+    return (int)parseSize(text, 0x40000000L);
 }
 
-/* writeToCache
- * ...
+/* remapMain
+ *
+ * Handles "./sim remap [--block-size <bytes>] <trace file> <id trace
+ * file>". The id trace only replays at the block size it was made for.
  */
 
-int writeToCache(Cache cache, char* address)
+static int remapMain(int argc, char **argv)
 {
-    unsigned int dec,i;
-    char *bstring, *bformatted, *tag;
+    int block_size, arg;
 
-    /* Validate inputs */
-    if (cache == NULL || address == NULL)
+    block_size = BLOCK_SIZE;
+    arg = 2;
+
+    if(arg + 1 < argc && strcmp(argv[arg], "--block-size") == 0)
     {
-        fprintf(stderr, "Error: Invalid cache or memory address.\n");
+        block_size = parseBytes(argv[arg + 1]);
+        if(block_size == -1)
+        {
+            fprintf(stderr, "Invalid --block-size: %s\n", argv[arg + 1]);
+            return 0;
+        }
+        arg = arg + 2;
+    }
+
+    if(arg != argc - 2)
+    {
+        fprintf(stderr, "Usage: ./sim remap [--block-size <bytes>] <trace file> <id trace file>\n");
         return 0;
     }
 
-    /* Convert and parse necessary values */
-    dec = htoi(address);
-    bstring = getBinary(dec);
-    bformatted = formatBinary(bstring);
+    return remapTrace(argv[arg], argv[arg + 1], block_size);
+}
 
-    i = 0;
-    
-    tag = (char *)malloc(sizeof(char) * (TAG + 1));
-    assert(tag != NULL);
-    tag[TAG] = '\0';
+/* translateAccess
+ *
+ * Looks up every page an access of size bytes at address touches in
+ * the TLB. With walk set, the page table reads of every page walk go
+ * through cache ahead of the access itself. Returns the number of page
+ * table reads sent.
+ */
+
+static unsigned long translateAccess(Tlb tlb, Cache cache, unsigned long pc, unsigned long address,
+                                     unsigned long size, int walk)
+{
+    unsigned long page, last, entries[TLB_WALK_LEVELS], reads;
+    int n, i;
 
-    for (i = 0; i < TAG; i++)
+    page = address >> tlbPageBits(tlb);
+    last = page;
+    if (size > 1 && address + size - 1 > address)
     {
-        tag[i] = bformatted[i];
+        last = (address + size - 1) >> tlbPageBits(tlb);
     }
 
-    for (int i = 0; i < cache->cache_size / cache->block_size; i++)
+    reads = 0;
+    for (;;)
     {
-        Block block = cache->blocks[i];
-
-        if (block != NULL && block->valid == 1 && strcmp(block->tag, tag) == 0)
+        if (tlbAccess(tlb, page << tlbPageBits(tlb)) == TLB_WALK && walk)
         {
-            if (cache->write_policy == 0)
+            n = tlbWalk(tlb, page << tlbPageBits(tlb), entries);
+            for (i = 0; i < n; i++)
             {
-                cache->writes++;
+                accessCachePc(cache, pc, entries[i], 0);
             }
-            block->dirty = 1;
-            cache->hits++;
-            free(tag);
-            return 1;
+            reads += (unsigned long)n;
         }
-    }
-
-    /* Block not found, allocate memory and add it to the cache */
-    Block newBlock = (Block)malloc(sizeof(struct Block_));
-    assert(newBlock != NULL);
-    newBlock->valid = 1;
-    newBlock->dirty = 1;
-    newBlock->tag = tag;
 
-    /* Find an empty spot in the cache to store the block */
-    for (int i = 0; i < cache->cache_size / cache->block_size; i++)
-    {
-        if (cache->blocks[i] == NULL)
+        if (page == last)
         {
-            cache->blocks[i] = newBlock;
-            cache->misses++;
-            cache->reads++;
-            return 1;
+            break;
         }
+        page++;
     }
 
-    /* If no empty spot found, replace a block using a replacement policy (e.g., LRU) */
-    free(newBlock->tag);
-    free(newBlock);
-
-    return 0;
+    return reads;
 }
 
-/* printCache
- * ...
+/* accessPhysical
+ *
+ * accessCacheSized for a virtual address: the access goes to the cache
+ * at its physical address. Pages are at least a block, so only an
+ * access crossing a page boundary can land in two places; it is sent
+ * one page at a time and still counted as one split access.
  */
 
-void printCache(Cache cache)
+static void accessPhysical(Cache cache, PageMap map, unsigned long pc, unsigned long address,
+                           unsigned long size, int write)
 {
-    if (cache != NULL)
+    unsigned long end, piece, splits;
+
+    end = (size > 1 && address + size - 1 > address) ? address + size - 1 : address;
+
+    if (map == NULL || (address >> pageMapPageBits(map)) == (end >> pageMapPageBits(map)))
     {
-        for (int i = 0; i < cache->cache_size / cache->block_size; i++)
+        accessCacheSized(cache, pc, map != NULL ? pageMapTranslate(map, address) : address, size, write);
+        return;
+    }
+
+    splits = cache->splits;
+    for (;;)
+    {
+        piece = ((address >> pageMapPageBits(map)) + 1) << pageMapPageBits(map);
+        if (piece == 0 || piece > end)
         {
-            Block block = cache->blocks[i];
-            char* tag = (block != NULL) ? block->tag : "NULL";
-            printf("[%i]: { valid: %i, tag: %s }\n", i, (block != NULL) ? block->valid : 0, tag);
+            accessCacheSized(cache, pc, pageMapTranslate(map, address), end - address + 1, write);
+            break;
         }
 
-        printf("Cache:\n\tCACHE HITS: %i\n\tCACHE MISSES: %i\n\tREADS: %i\n\tWRITES: %i\n\n", cache->hits, cache->misses, cache->reads, cache->writes);
+        accessCacheSized(cache, pc, pageMapTranslate(map, address), piece - address, write);
+        address = piece;
     }
+    cache->splits = splits + 1;
 }
 
+/* simulateFetch
+ *
+ * Sends an instruction fetch of size bytes at pc to cache, once per
+ * fetch block: a fetch from the same block as the previous fetch is
+ * part of the same fetch and is not sent again. lastBlock holds the
+ * previous fetch block. Blocks are looked up in map, if given, at
+ * their physical address. Returns the number of blocks fetched.
+ */
+
+static unsigned long simulateFetch(Cache cache, PageMap map, unsigned long pc, unsigned long size, unsigned long *lastBlock)
+{
+    unsigned long block, endBlock, fetched;
+
+    block = pc >> cache->offset_bits;
+    endBlock = (pc + (size > 0 ? size - 1 : 0)) >> cache->offset_bits;
+    fetched = 0;
+
+    for(; block <= endBlock; block++)
+    {
+        if(block != *lastBlock)
+        {
+            accessCachePc(cache, pc, map != NULL ? pageMapTranslate(map, block << cache->offset_bits)
+                                                 : block << cache->offset_bits, 0);
+            *lastBlock = block;
+            fetched++;
+        }
+    }
+
+    return fetched;
+}
+
+/* runIdTrace
+ *
+ * Replays an id trace written by ./sim remap. The cache switches to a
+ * residency array indexed by block id, so the loop below does no
+ * hashing and no parsing. The counters go into report if there is one.
+ */
+
+static int runIdTrace(Cache cache, const char *path, Report report)
+{
+    IdTrace trace;
+    const unsigned int *stream;
+    unsigned long i, length;
+    double started;
+
+    trace = loadIdTrace(path);
+    if(trace == NULL)
+    {
+        fprintf(stderr, "Error: Could not read id trace.\n");
+        return 0;
+    }
+
+    if(idTraceBlockSize(trace) != cache->block_size)
+    {
+        fprintf(stderr, "Error: Id trace was remapped for %i byte blocks.\n", idTraceBlockSize(trace));
+        destroyIdTrace(trace);
+        return 0;
+    }
+
+    cacheUseDenseIds(cache, idTraceDistinct(trace));
+
+    stream = idTraceStream(trace);
+    length = idTraceLength(trace);
+    started = reportClock();
+
+    for(i = 0; i < length; i++)
+    {
+        accessCacheId(cache, stream[i] >> 1, (int)(stream[i] & 1));
+    }
+
+    if(report != NULL)
+    {
+        reportRun(report, length, reportClock() - started);
+        reportCounters(report, "cache", cache);
+    }
+    else
+    {
+        printCounters(cache);
+    }
+    destroyIdTrace(trace);
+
+    return 1;
+}
+
+/*
+ * Algorithm:
+ *  1. Validate inputs
+ *  2. Create a new cache object
+ *  3. Open the trace file for reading (id traces are replayed whole)
+ *  4. Read a line from the file
+ *  5. Parse the line and read or write accordingly
+ *  6. If the line is "#eof" continue, otherwise go back to step 4 
+ *  7. Print the results
+ *  8. Destroy the cache object
+ *  9. Close the file
+ */
+
+int main(int argc, char **argv)
+{
+    /* Local Variables */
+    int write_policy, replacement, filter_format, collapse, arg, status;
+    long cache_size;
+    int block_size, icache_size, icache_block, unified, seenFetch, timing, core;
+    unsigned long counter, runs, start, count, interval, last[2], fetches, lastFetch;
+    unsigned long hit_latency, icache_latency, memory_latency, instructions, stalls;
+    int mshr_entries, use_dram, dram_channels, dram_banks, dram_row, dram_page;
+    MshrStats mshrStats;
+    BloomStats bloomStats;
+    Dram dram;
+    DramStats dramStats;
+    int use_tlb, dtlb_entries, stlb_entries, page_size, page_walk, walked, level;
+    unsigned long walkReads, walkEntries[TLB_WALK_LEVELS];
+    Tlb tlb;
+    TlbStats tlbStats;
+    int allocator, colors;
+    long phys_mem;
+    PageMap map;
+    int infer_regions, num_regions, region;
+    const char *region_specs[REGION_MAX];
+    RegionTable regions;
+    int hot_k, hot_counters, hot_exact;
+    int bloom_counters;
+    int compact, idTrace;
+    TopK hot_misses, hot_writes;
+    int format;
+    const char *translate_name;
+    Report report;
+    double started, seconds;
+    Cache cache, icache, fetchCache;
+    TraceReader reader;
+    TraceIndex index;
+    TraceWriter filter;
+    Access access;
+    Run run;
+    const char *filter_path;
+    char *path, *end;
+    
+    /* Help Menu
+     *
+     * If the help flag is present or there are fewer than
+     * three arguments, print the usage menu and return. 
+     */
+     
+    if(argc < 3 || strcmp(argv[1], "-h") == 0)
+    {
+        printUsage();
+        return 0;
+    }
+    
+    /* Object Cache Mode */
+    if(strcmp(argv[1], "object") == 0)
+    {
+        return objectMain(argc, argv);
+    }
+    
+    /* Trace Statistics */
+    if(strcmp(argv[1], "stats") == 0)
+    {
+        if(argc == 4 && strcmp(argv[2], "--approx") == 0)
+        {
+            return traceStats(argv[3], 1);
+        }
+        else if(argc != 3)
+        {
+            fprintf(stderr, "Usage: ./sim stats [--approx] <trace file>\n");
+            return 0;
+        }
+        return traceStats(argv[2], 0);
+    }
+    
+    /* Trace Index */
+    if(strcmp(argv[1], "index") == 0)
+    {
+        return indexMain(argc, argv);
+    }
+    
+    /* Dense Id Remapping */
+    if(strcmp(argv[1], "remap") == 0)
+    {
+        return remapMain(argc, argv);
+    }
+    
+    /* Options */
+    replacement = POLICY_LRU;
+    filter_path = NULL;
+    filter_format = TRACE_TEXT;
+    collapse = 0;
+    start = 0;
+    count = 0;
+    interval = 0;
+    cache_size = CACHE_SIZE;
+    block_size = BLOCK_SIZE;
+    icache_size = 0;
+    icache_block = 0;
+    unified = 0;
+    timing = 0;
+    core = 0;
+    hit_latency = DEFAULT_HIT_LATENCY;
+    icache_latency = DEFAULT_HIT_LATENCY;
+    memory_latency = DEFAULT_MEMORY_LATENCY;
+    mshr_entries = 0;
+    use_dram = 0;
+    dram_channels = DRAM_CHANNELS;
+    dram_banks = DRAM_BANKS;
+    dram_row = DRAM_ROW_SIZE;
+    dram_page = DRAM_OPEN_PAGE;
+    use_tlb = 0;
+    dtlb_entries = TLB_DTLB_ENTRIES;
+    stlb_entries = TLB_STLB_ENTRIES;
+    page_size = TLB_PAGE_SIZE;
+    page_walk = 0;
+    allocator = -1;
+    colors = PAGEMAP_COLORS;
+    phys_mem = PAGEMAP_PHYS_MEM;
+    infer_regions = 0;
+    num_regions = 0;
+    hot_k = 0;
+    hot_counters = TOPK_COUNTERS;
+    hot_exact = 0;
+    bloom_counters = 0;
+    compact = 0;
+    format = REPORT_TEXT;
+    translate_name = NULL;
+    
+    for(arg = 1; arg < argc - 2 && strncmp(argv[arg], "--", 2) == 0; arg++)
+    {
+        if(strcmp(argv[arg], "--policy") == 0 && arg + 1 < argc - 2)
+        {
+            arg++;
+            replacement = parsePolicy(argv[arg]);
+            if(replacement == -1)
+            {
+                fprintf(stderr, "Invalid Replacement Policy: %s\n", argv[arg]);
+                return 0;
+            }
+        }
+        else if(strcmp(argv[arg], "--collapse") == 0)
+        {
+            collapse = 1;
+        }
+        else if(strcmp(argv[arg], "--core") == 0)
+        {
+            core = 1;
+            timing = 1;
+        }
+        else if((strcmp(argv[arg], "--start") == 0 || strcmp(argv[arg], "--count") == 0 ||
+                 strcmp(argv[arg], "--interval") == 0 || strcmp(argv[arg], "--hit-latency") == 0 ||
+                 strcmp(argv[arg], "--icache-latency") == 0 || strcmp(argv[arg], "--memory-latency") == 0 ||
+                 strcmp(argv[arg], "--mshrs") == 0 || strcmp(argv[arg], "--dtlb") == 0 ||
+                 strcmp(argv[arg], "--stlb") == 0 || strcmp(argv[arg], "--colors") == 0 ||
+                 strcmp(argv[arg], "--hot") == 0 || strcmp(argv[arg], "--hot-counters") == 0 ||
+                 strcmp(argv[arg], "--bloom-counters") == 0) &&
+                arg + 1 < argc - 2)
+        {
+            arg++;
+            if(strcmp(argv[arg - 1], "--start") == 0)
+            {
+                start = strtoul(argv[arg], &end, 10);
+            }
+            else if(strcmp(argv[arg - 1], "--count") == 0)
+            {
+                count = strtoul(argv[arg], &end, 10);
+            }
+            else if(strcmp(argv[arg - 1], "--interval") == 0)
+            {
+                interval = strtoul(argv[arg], &end, 10);
+            }
+            else if(strcmp(argv[arg - 1], "--hit-latency") == 0)
+            {
+                hit_latency = strtoul(argv[arg], &end, 10);
+                icache_latency = hit_latency;
+                timing = 1;
+            }
+            else if(strcmp(argv[arg - 1], "--icache-latency") == 0)
+            {
+                icache_latency = strtoul(argv[arg], &end, 10);
+                timing = 1;
+            }
+            else if(strcmp(argv[arg - 1], "--memory-latency") == 0)
+            {
+                memory_latency = strtoul(argv[arg], &end, 10);
+                timing = 1;
+            }
+            else if(strcmp(argv[arg - 1], "--dtlb") == 0)
+            {
+                dtlb_entries = (int)strtoul(argv[arg], &end, 10);
+                use_tlb = 1;
+            }
+            else if(strcmp(argv[arg - 1], "--stlb") == 0)
+            {
+                stlb_entries = (int)strtoul(argv[arg], &end, 10);
+                use_tlb = 1;
+            }
+            else if(strcmp(argv[arg - 1], "--colors") == 0)
+            {
+                colors = (int)strtoul(argv[arg], &end, 10);
+            }
+            else if(strcmp(argv[arg - 1], "--hot") == 0)
+            {
+                hot_k = (int)strtoul(argv[arg], &end, 10);
+                if( hot_k <= 0 )
+                {
+                    fprintf(stderr, "Invalid number of hot blocks.\n");
+                    return 0;
+                }
+            }
+            else if(strcmp(argv[arg - 1], "--hot-counters") == 0)
+            {
+                hot_counters = (int)strtoul(argv[arg], &end, 10);
+                if( hot_counters <= 0 )
+                {
+                    fprintf(stderr, "Invalid number of hot counters.\n");
+                    return 0;
+                }
+                hot_k = hot_k ? hot_k : TOPK_REPORT;
+            }
+            else if(strcmp(argv[arg - 1], "--bloom-counters") == 0)
+            {
+                bloom_counters = (int)strtoul(argv[arg], &end, 10);
+                if( bloom_counters <= 0 )
+                {
+                    fprintf(stderr, "Invalid number of Bloom filter counters.\n");
+                    return 0;
+                }
+            }
+            else
+            {
+                mshr_entries = (int)strtoul(argv[arg], &end, 10);
+                if( mshr_entries <= 0 )
+                {
+                    fprintf(stderr, "Invalid number of MSHRs.\n");
+                    return 0;
+                }
+                timing = 1;
+            }
+            
+            if(*end != '\0' || argv[arg][0] == '\0')
+            {
+                fprintf(stderr, "Invalid %s: %s\n", argv[arg - 1], argv[arg]);
+                return 0;
+            }
+        }
+        else if(strcmp(argv[arg], "--unified") == 0)
+        {
+            unified = 1;
+        }
+        else if(strcmp(argv[arg], "--dram") == 0)
+        {
+            use_dram = 1;
+        }
+        else if(strcmp(argv[arg], "--tlb") == 0)
+        {
+            use_tlb = 1;
+        }
+        else if(strcmp(argv[arg], "--page-walk") == 0)
+        {
+            use_tlb = 1;
+            page_walk = 1;
+        }
+        else if(strcmp(argv[arg], "--hot-exact") == 0)
+        {
+            hot_exact = 1;
+            hot_k = hot_k ? hot_k : TOPK_REPORT;
+        }
+        else if(strcmp(argv[arg], "--bloom") == 0)
+        {
+            bloom_counters = bloom_counters ? bloom_counters : BLOOM_COUNTERS;
+        }
+        else if(strcmp(argv[arg], "--compact") == 0)
+        {
+            compact = 1;
+        }
+        else if(strcmp(argv[arg], "--regions") == 0)
+        {
+            infer_regions = 1;
+        }
+        else if(strcmp(argv[arg], "--region") == 0 && arg + 1 < argc - 2)
+        {
+            arg++;
+            if(num_regions == REGION_MAX)
+            {
+                fprintf(stderr, "Too many regions.\n");
+                return 0;
+            }
+            region_specs[num_regions++] = argv[arg];
+        }
+        else if(strcmp(argv[arg], "--translate") == 0 && arg + 1 < argc - 2)
+        {
+            arg++;
+            allocator = parsePageMap(argv[arg]);
+            if(allocator == -1)
+            {
+                fprintf(stderr, "Invalid Page Allocator: %s\n", argv[arg]);
+                return 0;
+            }
+            translate_name = argv[arg];
+        }
+        else if(strcmp(argv[arg], "--phys-mem") == 0 && arg + 1 < argc - 2)
+        {
+            arg++;
+            phys_mem = parseSize(argv[arg], 1L << 48);
+            if(phys_mem == -1)
+            {
+                fprintf(stderr, "Invalid %s: %s\n", argv[arg - 1], argv[arg]);
+                return 0;
+            }
+        }
+        else if(strcmp(argv[arg], "--dram-page") == 0 && arg + 1 < argc - 2)
+        {
+            arg++;
+            use_dram = 1;
+            if(strcmp(argv[arg], "open") == 0)
+            {
+                dram_page = DRAM_OPEN_PAGE;
+            }
+            else if(strcmp(argv[arg], "closed") == 0)
+            {
+                dram_page = DRAM_CLOSED_PAGE;
+            }
+            else
+            {
+                fprintf(stderr, "Invalid Page Policy: %s\n", argv[arg]);
+                return 0;
+            }
+        }
+        else if((strcmp(argv[arg], "--cache-size") == 0 || strcmp(argv[arg], "--block-size") == 0 ||
+                 strcmp(argv[arg], "--icache") == 0 || strcmp(argv[arg], "--icache-block") == 0 ||
+                 strcmp(argv[arg], "--dram-channels") == 0 || strcmp(argv[arg], "--dram-banks") == 0 ||
+                 strcmp(argv[arg], "--dram-row") == 0 || strcmp(argv[arg], "--page-size") == 0) && arg + 1 < argc - 2)
+        {
+            arg++;
+            if((strcmp(argv[arg - 1], "--cache-size") == 0 ? parseSize(argv[arg], CACHE_SIZE_MAX) : parseBytes(argv[arg])) == -1)
+            {
+                fprintf(stderr, "Invalid %s: %s\n", argv[arg - 1], argv[arg]);
+                return 0;
+            }
+            
+            if(strcmp(argv[arg - 1], "--cache-size") == 0)
+            {
+                cache_size = parseSize(argv[arg], CACHE_SIZE_MAX);
+            }
+            else if(strcmp(argv[arg - 1], "--block-size") == 0)
+            {
+                block_size = parseBytes(argv[arg]);
+            }
+            else if(strcmp(argv[arg - 1], "--icache") == 0)
+            {
+                icache_size = parseBytes(argv[arg]);
+            }
+            else if(strcmp(argv[arg - 1], "--icache-block") == 0)
+            {
+                icache_block = parseBytes(argv[arg]);
+            }
+            else if(strcmp(argv[arg - 1], "--dram-channels") == 0)
+            {
+                dram_channels = parseBytes(argv[arg]);
+                use_dram = 1;
+            }
+            else if(strcmp(argv[arg - 1], "--dram-banks") == 0)
+            {
+                dram_banks = parseBytes(argv[arg]);
+                use_dram = 1;
+            }
+            else if(strcmp(argv[arg - 1], "--dram-row") == 0)
+            {
+                dram_row = parseBytes(argv[arg]);
+                use_dram = 1;
+            }
+            else
+            {
+                page_size = parseBytes(argv[arg]);
+            }
+        }
+        else if(strcmp(argv[arg], "--format") == 0 && arg + 1 < argc - 2)
+        {
+            arg++;
+            format = parseReportFormat(argv[arg]);
+            if(format == -1)
+            {
+                fprintf(stderr, "Invalid Format: %s\n", argv[arg]);
+                return 0;
+            }
+        }
+        else if(strcmp(argv[arg], "--filter") == 0 && arg + 1 < argc - 2)
+        {
+            filter_path = argv[++arg];
+        }
+        else if(strcmp(argv[arg], "--filter-format") == 0 && arg + 1 < argc - 2)
+        {
+            arg++;
+            if(strcmp(argv[arg], "text") == 0)
+            {
+                filter_format = TRACE_TEXT;
+            }
+            else if(strcmp(argv[arg], "binary") == 0)
+            {
+                filter_format = TRACE_BINARY;
+            }
+            else
+            {
+                fprintf(stderr, "Invalid Filter Format: %s\n", argv[arg]);
+                return 0;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Invalid Option: %s\nUsage: ./sim [-h] [options] <write policy> <trace file>\n", argv[arg]);
+            return 0;
+        }
+    }
+    
+    if(arg != argc - 2)
+    {
+        fprintf(stderr, "Usage: ./sim [-h] [options] <write policy> <trace file>\n");
+        return 0;
+    }
+    
+    /* Write Policy */
+    if(strcmp(argv[arg], "wt") == 0)
+    {
+        write_policy = 0;
+        if(DEBUG) printf("Write Policy: Write Through\n");
+    }
+    else if(strcmp(argv[arg], "wb") == 0)
+    {
+        write_policy = 1;
+        if(DEBUG) printf("Write Policy: Write Back\n");
+    }
+    else
+    {
+        fprintf(stderr, "Invalid Write Policy.\nUsage: ./sim [-h] [options] <write policy> <trace file>\n");
+        return 0;
+    }
+    
+    /* A run can straddle the end of the slice */
+    if( collapse && count > 0 )
+    {
+        fprintf(stderr, "Error: --count cannot be combined with --collapse.\n");
+        return 0;
+    }
+    
+    if( icache_size > 0 && unified )
+    {
+        fprintf(stderr, "Error: --icache and --unified cannot be combined.\n");
+        return 0;
+    }
+    
+    /* Runs are made of data accesses only */
+    if( (icache_size > 0 || unified) && collapse )
+    {
+        fprintf(stderr, "Error: instruction fetches cannot be simulated with --collapse.\n");
+        return 0;
+    }
+    
+    /* Runs are timed as a block of hits */
+    if( mshr_entries > 0 && collapse )
+    {
+        fprintf(stderr, "Error: --mshrs cannot be combined with --collapse.\n");
+        return 0;
+    }
+    
+    cache = createCache(cache_size, block_size, write_policy, replacement);
+    if( cache == NULL )
+    {
+        return 0;
+    }
+    cacheSetLatency(cache, hit_latency, memory_latency);
+    if( (mshr_entries > 0 && !cacheSetMshrs(cache, mshr_entries)) ||
+        (bloom_counters > 0 && !cacheSetBloom(cache, bloom_counters)) ||
+        (compact && !cacheSetCompact(cache)) )
+    {
+        destroyCache(cache);
+        return 0;
+    }
+    
+    /* Instruction fetches go to their own cache, the data cache
+       (--unified) or nowhere */
+    icache = NULL;
+    fetchCache = NULL;
+    if( icache_size > 0 )
+    {
+        icache = createCache(icache_size, icache_block > 0 ? icache_block : block_size, write_policy, replacement);
+        if( icache == NULL )
+        {
+            destroyCache(cache);
+            return 0;
+        }
+        cacheSetLatency(icache, icache_latency, memory_latency);
+        fetchCache = icache;
+    }
+    else if( unified )
+    {
+        fetchCache = cache;
+    }
+    
+    /* Machine readable results start with the whole configuration, so
+       every run of a sweep has the same config columns */
+    report = NULL;
+    if( format != REPORT_TEXT )
+    {
+        report = createReport(format);
+        reportBegin(report, "config");
+        reportString(report, "trace", argv[arg + 1]);
+        reportString(report, "write_policy", argv[arg]);
+        reportString(report, "policy", policyName(replacement));
+        reportInt(report, "cache_size", (unsigned long)cache_size);
+        reportInt(report, "block_size", (unsigned long)block_size);
+        reportInt(report, "icache_size", (unsigned long)icache_size);
+        reportInt(report, "icache_block", (unsigned long)(icache != NULL ? icache->block_size : 0));
+        reportInt(report, "unified", (unsigned long)unified);
+        reportInt(report, "hit_latency", hit_latency);
+        reportInt(report, "icache_latency", icache_latency);
+        reportInt(report, "memory_latency", memory_latency);
+        reportInt(report, "mshrs", (unsigned long)mshr_entries);
+        reportInt(report, "core", (unsigned long)core);
+        reportInt(report, "dram", (unsigned long)use_dram);
+        reportInt(report, "dram_channels", (unsigned long)dram_channels);
+        reportInt(report, "dram_banks", (unsigned long)dram_banks);
+        reportInt(report, "dram_row", (unsigned long)dram_row);
+        reportString(report, "dram_page", dram_page == DRAM_OPEN_PAGE ? "open" : "closed");
+        reportInt(report, "tlb", (unsigned long)use_tlb);
+        reportInt(report, "dtlb", (unsigned long)dtlb_entries);
+        reportInt(report, "stlb", (unsigned long)stlb_entries);
+        reportInt(report, "page_size", (unsigned long)page_size);
+        reportInt(report, "page_walk", (unsigned long)page_walk);
+        reportString(report, "translate", translate_name != NULL ? translate_name : "none");
+        reportInt(report, "phys_mem", (unsigned long)phys_mem);
+        reportInt(report, "colors", (unsigned long)colors);
+        reportInt(report, "regions", (unsigned long)(infer_regions || num_regions > 0));
+        reportInt(report, "hot", (unsigned long)hot_k);
+        reportInt(report, "hot_counters", (unsigned long)hot_counters);
+        reportInt(report, "hot_exact", (unsigned long)hot_exact);
+        reportInt(report, "bloom_counters", (unsigned long)bloom_counters);
+        reportInt(report, "compact", (unsigned long)compact);
+        reportInt(report, "collapse", (unsigned long)collapse);
+        reportInt(report, "start", start);
+        reportInt(report, "count", count);
+        reportInt(report, "interval", interval);
+        reportString(report, "filter", filter_path != NULL ? filter_path : "");
+        reportEnd(report);
+    }
+    
+    /* From here on every failure sets status to 0 and falls through to
+       the one teardown at the end, so each resource is destroyed once */
+    status = 1;
+    dram = NULL;
+    tlb = NULL;
+    map = NULL;
+    regions = NULL;
+    hot_misses = NULL;
+    hot_writes = NULL;
+    reader = NULL;
+    filter = NULL;
+    
+    /* Id traces from ./sim remap replay straight from memory. None of
+       the options set up below are allowed with them. */
+    idTrace = isIdTrace(argv[arg + 1]);
+    if( idTrace )
+    {
+        if( filter_path != NULL || start > 0 || count > 0 || interval > 0 || fetchCache != NULL || core || use_dram || use_tlb ||
+            allocator != -1 || infer_regions || num_regions > 0 || hot_k > 0 || bloom_counters > 0 )
+        {
+            fprintf(stderr, "Error: --filter, --start, --count, --interval, --icache, --unified, --core, --dram, --tlb, --translate, --regions, --hot and --bloom need a text or binary trace.\n");
+            status = 0;
+        }
+        else
+        {
+            status = runIdTrace(cache, argv[arg + 1], report);
+            if( status && report != NULL && !writeReport(report, stdout) )
+            {
+                fprintf(stderr, "Error: Could not write the report.\n");
+                status = 0;
+            }
+        }
+    }
+    
+    /* The DRAM sits behind the data cache only; instruction misses keep
+       the fixed memory latency */
+    if( status && use_dram )
+    {
+        dram = createDram(dram_channels, dram_banks, dram_row, dram_page);
+        if( dram == NULL )
+        {
+            status = 0;
+        }
+        else
+        {
+            cacheSetDram(cache, dram);
+            timing = 1;
+        }
+    }
+    
+    /* Data accesses are translated ahead of the data cache */
+    if( status && use_tlb )
+    {
+        tlb = createTlb(dtlb_entries, stlb_entries, page_size);
+        status = (tlb != NULL);
+    }
+    
+    /* The caches see physical addresses; the TLB still sees virtual
+       ones. Blocks may not straddle pages. */
+    if( status && allocator != -1 )
+    {
+        map = createPageMap(allocator, page_size, phys_mem, colors);
+        if( map != NULL && (cache->block_size > (1L << pageMapPageBits(map)) ||
+                            (icache != NULL && icache->block_size > (1L << pageMapPageBits(map)))) )
+        {
+            fprintf(stderr, "Error: blocks cannot be larger than the pages.\n");
+            destroyPageMap(map);
+            map = NULL;
+        }
+        
+        status = (map != NULL);
+    }
+    
+    /* Regions are virtual address ranges, given by hand or inferred
+       from a sample of the trace */
+    if( status && (infer_regions || num_regions > 0) )
+    {
+        regions = createRegionTable();
+        
+        if( map != NULL )
+        {
+            fprintf(stderr, "Error: --regions cannot be combined with --translate.\n");
+            status = 0;
+        }
+        
+        for( region = 0; status && region < num_regions; region++ )
+        {
+            if( !parseRegion(regions, region_specs[region]) )
+            {
+                fprintf(stderr, "Invalid Region: %s\n", region_specs[region]);
+                status = 0;
+            }
+        }
+        
+        if( status && num_regions == 0 && !inferRegions(regions, argv[arg + 1]) )
+        {
+            fprintf(stderr, "Error: Could not infer regions; give them with --region.\n");
+            status = 0;
+        }
+        
+        if( status )
+        {
+            cacheSetRegions(cache, regions);
+        }
+    }
+    
+    /* Hot blocks, by physical address under --translate */
+    if( status && hot_k > 0 )
+    {
+        hot_misses = createTopK(hot_counters, hot_exact);
+        hot_writes = createTopK(hot_counters, hot_exact);
+        
+        status = (hot_misses != NULL && hot_writes != NULL);
+        if( status )
+        {
+            cacheSetHotBlocks(cache, hot_misses, hot_writes);
+        }
+    }
+    
+    /* Open the file for reading. */
+    if( status && !idTrace )
+    {
+        reader = openTrace( argv[arg + 1] );
+        if( reader == NULL )
+        {
+            fprintf(stderr, "Error: Could not open file.\n");
+            status = 0;
+        }
+    }
+    
+    /* Skip to the first access of the slice */
+    if( status && start > 0 )
+    {
+        path = indexPath(argv[arg + 1]);
+        index = loadTraceIndex(path, argv[arg + 1]);
+        status = seekTraceIndex(reader, index, start);
+        destroyTraceIndex(index);
+        free(path);
+        
+        if( status != 1 )
+        {
+            fprintf(stderr, "Error: Could not seek to access %lu.\n", start);
+            status = 0;
+        }
+    }
+    
+    /* Accesses that cross a block boundary touch every block they
+       cover. The engine splits them (accessCacheSized), except that
+       runs are formed from blocks so the reader splits for them. */
+    if( status && !idTrace )
+    {
+        if( collapse )
+        {
+            traceSplitBlocks(reader, cache->offset_bits);
+        }
+        traceIncludeFetches(reader, fetchCache != NULL || (core && !collapse));
+    }
+    
+    if( status && filter_path != NULL )
+    {
+        filter = createTraceWriter(filter_path, filter_format);
+        status = (filter != NULL);
+        if( status )
+        {
+            cacheSetFilter(cache, filter);
+            
+            if( icache != NULL )
+            {
+                cacheSetFilter(icache, filter);
+            }
+        }
+    }
+    
+    /* Run the trace and print the results */
+    if( status && !idTrace )
+    {
+        counter = 0;
+        runs = 0;
+        last[0] = 0;
+        last[1] = 0;
+        fetches = 0;
+        lastFetch = ~0UL;
+        seenFetch = 0;
+        instructions = 0;
+        walkReads = 0;
+        
+        if( report != NULL && interval > 0 )
+        {
+            reportBeginList(report, "intervals");
+        }
+        started = reportClock();
+        
+        if( collapse )
+        {
+            while( (status = readTraceRun(reader, cache->offset_bits, &run)) == 1 )
+            {
+                PROFILE_SAMPLE();
+                
+                if( tlb != NULL && tlbAccessRun(tlb, run.address, run.count) == TLB_WALK && page_walk )
+                {
+                    walked = tlbWalk(tlb, run.address, walkEntries);
+                    for( level = 0; level < walked; level++ )
+                    {
+                        accessCachePc(cache, run.pc, walkEntries[level], 0);
+                    }
+                    walkReads += (unsigned long)walked;
+                }
+                
+                accessCacheRun(cache, run.pc, map != NULL ? pageMapTranslate(map, run.address) : run.address,
+                               run.write, run.count, run.writes);
+                counter += run.count;
+                runs++;
+                
+                if( interval > 0 && counter / interval != (counter - run.count) / interval )
+                {
+                    PROFILE_BEGIN(PROFILE_STATS);
+                    printInterval(cache, counter, last, report);
+                    PROFILE_END(PROFILE_STATS);
+                }
+            }
+        }
+        else
+        {
+            while( (count == 0 || counter < count) && (status = readTrace(reader, &access)) == 1 )
+            {
+                PROFILE_SAMPLE();
+                
+                if(DEBUG) printf("%lu: %c 0x%lx\n", counter, access.write ? 'W' : 'R', access.address);
+                
+                /* Traces with fetch records (Lackey) give the fetches;
+                   otherwise every access implies a fetch of its pc */
+                if( access.fetch )
+                {
+                    seenFetch = 1;
+                    instructions++;
+                    
+                    if( fetchCache != NULL )
+                    {
+                        fetches += simulateFetch(fetchCache, map, access.address, access.size, &lastFetch);
+                    }
+                    continue;
+                }
+                
+                if( fetchCache != NULL && !seenFetch )
+                {
+                    fetches += simulateFetch(fetchCache, map, access.pc, 0, &lastFetch);
+                }
+                
+                if( tlb != NULL )
+                {
+                    walkReads += translateAccess(tlb, cache, access.pc, access.address, access.size, page_walk);
+                }
+                
+                accessPhysical(cache, map, access.pc, access.address, access.size, access.write);
+                counter++;
+                
+                if( interval > 0 && counter % interval == 0 )
+                {
+                    PROFILE_BEGIN(PROFILE_STATS);
+                    printInterval(cache, counter, last, report);
+                    PROFILE_END(PROFILE_STATS);
+                }
+            }
+        }
+        
+        if( status == -1 )
+        {
+            printf("%lu: ERROR!!!!\n", start + counter);
+            status = 0;
+        }
+        else
+        {
+            seconds = reportClock() - started;
+            if( report != NULL && interval > 0 )
+            {
+                reportEnd(report);
+            }
+            
+            if(DEBUG) printf("Num Lines: %lu\n", counter);
+            
+            /* The clock stops at the last fill, and the stalls seen by the
+               in-order core follow from the running cycle sums */
+            if( mshr_entries > 0 )
+            {
+                cacheMshrStats(cache, &mshrStats);
+            }
+            
+            stalls = 0;
+            status = 1;
+            if( core )
+            {
+                if( !seenFetch )
+                {
+                    instructions = counter;
+                }
+                
+                /* With MSHRs the data cache only stalls the core when they are full */
+                if( mshr_entries > 0 )
+                {
+                    stalls = mshrStats.stallCycles;
+                }
+                else
+                {
+                    stalls = cache->cycles - cache->hitLatency * (cache->hits + cache->misses);
+                }
+                if( icache != NULL )
+                {
+                    stalls += icache->cycles - icache->hitLatency * (icache->hits + icache->misses);
+                }
+            }
+            
+            if( report != NULL )
+            {
+                reportRun(report, counter, seconds);
+                reportCounters(report, "cache", cache);
+                
+                if( icache != NULL )
+                {
+                    reportCounters(report, "icache", icache);
+                }
+                
+                if( fetchCache != NULL )
+                {
+                    reportBegin(report, "fetch");
+                    reportInt(report, "blocks", fetches);
+                    reportEnd(report);
+                }
+                
+                if( mshr_entries > 0 )
+                {
+                    reportBegin(report, "mshr");
+                    reportInt(report, "cycles", mshrStats.last > cache->now ? mshrStats.last : cache->now);
+                    reportReal(report, "mlp", mshrStats.busyCycles ? (double)mshrStats.missCycles / (double)mshrStats.busyCycles : 0.0);
+                    reportInt(report, "full_stalls", mshrStats.fullStalls);
+                    reportInt(report, "stall_cycles", mshrStats.stallCycles);
+                    reportInt(report, "merged_misses", mshrStats.merged);
+                    reportEnd(report);
+                }
+                
+                if( bloom_counters > 0 )
+                {
+                    cacheBloomStats(cache, &bloomStats);
+                    reportBegin(report, "bloom");
+                    reportInt(report, "lookups", bloomStats.lookups);
+                    reportInt(report, "rejected", bloomStats.rejected);
+                    reportInt(report, "false_positives", bloomStats.falsePositives);
+                    reportReal(report, "false_positive_rate", (bloomStats.rejected + bloomStats.falsePositives) ?
+                               (double)bloomStats.falsePositives / (double)(bloomStats.rejected + bloomStats.falsePositives) : 0.0);
+                    reportEnd(report);
+                }
+                
+                if( tlb != NULL )
+                {
+                    tlbGetStats(tlb, &tlbStats);
+                    reportBegin(report, "tlb");
+                    reportInt(report, "dtlb_hits", tlbStats.dtlbHits);
+                    reportInt(report, "dtlb_misses", tlbStats.dtlbMisses);
+                    reportInt(report, "stlb_hits", tlbStats.stlbHits);
+                    reportInt(report, "page_walks", tlbStats.walks);
+                    reportInt(report, "page_walk_reads", walkReads);
+                    reportEnd(report);
+                }
+                
+                if( map != NULL )
+                {
+                    reportBegin(report, "pagemap");
+                    reportInt(report, "pages_mapped", pageMapPages(map));
+                    reportInt(report, "pages_reclaimed", pageMapReclaims(map));
+                    reportEnd(report);
+                }
+                
+                if( dram != NULL )
+                {
+                    dramGetStats(dram, &dramStats);
+                    reportBegin(report, "dram");
+                    reportInt(report, "reads", dramStats.reads);
+                    reportInt(report, "writes", dramStats.writes);
+                    reportInt(report, "row_hits", dramStats.rowHits);
+                    reportInt(report, "row_misses", dramStats.rowMisses);
+                    reportInt(report, "bank_conflicts", dramStats.rowConflicts);
+                    reportReal(report, "row_hit_rate", (dramStats.reads + dramStats.writes) ?
+                               (double)dramStats.rowHits / (double)(dramStats.reads + dramStats.writes) : 0.0);
+                    reportInt(report, "bank_wait_cycles", dramStats.bankWaitCycles);
+                    reportReal(report, "bandwidth", dramStats.last > dramStats.first ?
+                               (double)dramStats.bytes / (double)(dramStats.last - dramStats.first) : 0.0);
+                    reportReal(report, "bus_utilization", dramStats.last > dramStats.first ?
+                               (double)dramStats.busCycles / ((double)(dramStats.last - dramStats.first) * dramChannels(dram)) : 0.0);
+                    reportEnd(report);
+                }
+                
+                if( core )
+                {
+                    reportBegin(report, "core");
+                    reportInt(report, "instructions", instructions);
+                    reportInt(report, "stall_cycles", stalls);
+                    reportInt(report, "total_cycles", instructions + stalls);
+                    reportReal(report, "cpi", instructions ? (double)(instructions + stalls) / (double)instructions : 0.0);
+                    reportEnd(report);
+                }
+                
+                if( collapse )
+                {
+                    reportBegin(report, "collapse");
+                    reportInt(report, "runs", runs);
+                    reportInt(report, "collapsed_accesses", counter - runs);
+                    reportEnd(report);
+                }
+                
+                if( filter != NULL )
+                {
+                    reportBegin(report, "filter");
+                    reportInt(report, "records", traceWriterCount(filter));
+                    reportEnd(report);
+                }
+                
+                if( regions != NULL )
+                {
+                    reportRegions(regions, report);
+                }
+                
+                if( hot_misses != NULL )
+                {
+                    reportTopK(hot_misses, report, "hot_misses", hot_k);
+                    reportTopK(hot_writes, report, "hot_memory_writes", hot_k);
+                }
+                
+                PROFILE_REPORT(report);
+                
+                if( !writeReport(report, stdout) )
+                {
+                    fprintf(stderr, "Error: Could not write the report.\n");
+                    status = 0;
+                }
+            }
+            else
+            {
+                printCounters(cache);
+                
+                if( cache->splits > 0 )
+                {
+                    printf("SPLIT ACCESSES: %lu\n", cache->splits);
+                }
+                
+                if( regions != NULL )
+                {
+                    printRegions(regions);
+                }
+                
+                if( hot_misses != NULL )
+                {
+                    printTopK(hot_misses, "HOT MISSES", hot_k);
+                    printTopK(hot_writes, "HOT MEMORY WRITES", hot_k);
+                }
+                
+                if( icache != NULL )
+                {
+                    printf("ICACHE HITS: %lu\nICACHE MISSES: %lu\nICACHE MEMORY READS: %lu\n", icache->hits, icache->misses, icache->reads);
+                }
+                
+                if( fetchCache != NULL )
+                {
+                    printf("FETCH BLOCKS: %lu\n", fetches);
+                }
+                
+                /* Average memory access time. With the in-order core every
+                   instruction takes a cycle and each access stalls it for whatever
+                   the access takes beyond a hit; that total falls out of the
+                   running cycle sums, so nothing extra is done per access. */
+                if( timing )
+                {
+                    printf("ACCESS CYCLES: %lu\nAMAT: %.3f\n", cache->cycles,
+                           (cache->hits + cache->misses) ? (double)cache->cycles / (double)(cache->hits + cache->misses) : 0.0);
+                    
+                    if( icache != NULL )
+                    {
+                        printf("ICACHE ACCESS CYCLES: %lu\nICACHE AMAT: %.3f\n", icache->cycles,
+                               (icache->hits + icache->misses) ? (double)icache->cycles / (double)(icache->hits + icache->misses) : 0.0);
+                    }
+                }
+                
+                /* Non-blocking timing: the clock runs until the last fill returns,
+                   and MLP is the average number of misses in flight while any is */
+                if( mshr_entries > 0 )
+                {
+                    printf("MSHR CYCLES: %lu\nMLP: %.3f\nMSHR FULL STALLS: %lu\nMSHR STALL CYCLES: %lu\nMERGED MISSES: %lu\n",
+                           mshrStats.last > cache->now ? mshrStats.last : cache->now,
+                           mshrStats.busyCycles ? (double)mshrStats.missCycles / (double)mshrStats.busyCycles : 0.0,
+                           mshrStats.fullStalls, mshrStats.stallCycles, mshrStats.merged);
+                }
+                
+                /* The false positive rate is over lookups that missed: the share
+                   of them the filter failed to rule out */
+                if( bloom_counters > 0 )
+                {
+                    cacheBloomStats(cache, &bloomStats);
+                    printf("BLOOM LOOKUPS: %lu\nBLOOM REJECTED: %lu\nBLOOM FALSE POSITIVES: %lu\nBLOOM FALSE POSITIVE RATE: %.4f\n",
+                           bloomStats.lookups, bloomStats.rejected, bloomStats.falsePositives,
+                           (bloomStats.rejected + bloomStats.falsePositives) ?
+                           (double)bloomStats.falsePositives / (double)(bloomStats.rejected + bloomStats.falsePositives) : 0.0);
+                }
+                
+                if( tlb != NULL )
+                {
+                    tlbGetStats(tlb, &tlbStats);
+                    printf("DTLB HITS: %lu\nDTLB MISSES: %lu\n", tlbStats.dtlbHits, tlbStats.dtlbMisses);
+                    if( stlb_entries > 0 )
+                    {
+                        printf("STLB HITS: %lu\n", tlbStats.stlbHits);
+                    }
+                    printf("PAGE WALKS: %lu\n", tlbStats.walks);
+                    if( page_walk )
+                    {
+                        printf("PAGE WALK READS: %lu\n", walkReads);
+                    }
+                }
+                
+                if( map != NULL && allocator != PAGEMAP_IDENTITY )
+                {
+                    printf("PAGES MAPPED: %lu\n", pageMapPages(map));
+                    if( pageMapReclaims(map) > 0 )
+                    {
+                        printf("PAGES RECLAIMED: %lu\n", pageMapReclaims(map));
+                    }
+                }
+                
+                /* Bandwidth is the bytes moved over the cycles from the first
+                   request to the end of the last transfer */
+                if( dram != NULL )
+                {
+                    dramGetStats(dram, &dramStats);
+                    printf("DRAM READS: %lu\nDRAM WRITES: %lu\nDRAM ROW HITS: %lu\nDRAM ROW MISSES: %lu\nDRAM BANK CONFLICTS: %lu\n",
+                           dramStats.reads, dramStats.writes, dramStats.rowHits, dramStats.rowMisses, dramStats.rowConflicts);
+                    printf("DRAM ROW HIT RATE: %.3f\nDRAM BANK WAIT CYCLES: %lu\nDRAM BANDWIDTH: %.3f bytes/cycle\nDRAM BUS UTILIZATION: %.3f\n",
+                           (dramStats.reads + dramStats.writes) ? (double)dramStats.rowHits / (double)(dramStats.reads + dramStats.writes) : 0.0,
+                           dramStats.bankWaitCycles,
+                           dramStats.last > dramStats.first ? (double)dramStats.bytes / (double)(dramStats.last - dramStats.first) : 0.0,
+                           dramStats.last > dramStats.first ? (double)dramStats.busCycles / ((double)(dramStats.last - dramStats.first) * dramChannels(dram)) : 0.0);
+                }
+                
+                if( core )
+                {
+                    printf("INSTRUCTIONS: %lu\nSTALL CYCLES: %lu\nTOTAL CYCLES: %lu\nCPI: %.3f\n", instructions, stalls,
+                           instructions + stalls, instructions ? (double)(instructions + stalls) / (double)instructions : 0.0);
+                }
+                
+                if( collapse )
+                {
+                    printf("RUNS: %lu\nCOLLAPSED ACCESSES: %lu\n", runs, counter - runs);
+                }
+                
+                if( filter != NULL )
+                {
+                    printf("FILTERED RECORDS: %lu\n", traceWriterCount(filter));
+                }
+                
+                PROFILE_PRINT();
+            }
+        }
+    }
+    
+    /* Close the files, destroy the cache. */
+    
+    closeTrace(reader);
+    if( !closeTraceWriter(filter) )
+    {
+        fprintf(stderr, "Error: Could not write the filtered trace.\n");
+        status = 0;
+    }
+    destroyCache(cache);
+    destroyCache(icache);
+    destroyReport(report);
+    destroyDram(dram);
+    destroyTlb(tlb);
+    destroyPageMap(map);
+    destroyRegionTable(regions);
+    destroyTopK(hot_misses);
+    destroyTopK(hot_writes);
+    
+    return status;
+}
+
+/********************************
+ *     5. Cache Functions       *
+ ********************************/
+ 
+/* Function List:
+ *
+ * 1) createCache
+ * 2) destroyCache
+ * 3) readFromCache
+ * 4) writeToCache
+ * 5) accessCache
+ * 6) accessCachePc
+ * 7) accessCacheSized
+ * 8) accessCacheRun
+ * 9) cacheUseDenseIds
+ * 10) accessCacheId
+ * 11) cacheSetLatency
+ * 12) cacheSetMshrs
+ * 13) cacheMshrStats
+ * 14) cacheSetDram
+ * 15) cacheSetRegions
+ * 16) cacheSetHotBlocks
+ * 17) cacheSetFilter
+ * 18) cacheSetBloom
+ * 19) cacheBloomStats
+ * 20) cacheSetCompact
+ * 21) printCache
+ */
+
+
+/* lineTag
+ *
+ * TagSource of the replacement policy and of a compact index: reads the
+ * tag back from the line store.
+ */
+
+static unsigned long lineTag(const void* context, int line)
+{
+    return lineStoreTag(((const struct Cache_*)context)->lines, line);
+}
+
+/* createCache
+ *
+ * Function to create a new cache struct.  Returns the new struct on success
+ * and NULL on failure.
+ *
+ * @param   cache_size      size of cache in bytes
+ * @param   block_size      size of each block in bytes (a power of two)
+ * @param   write_policy    0 = write through, 1 = write back
+ * @param   replacement     POLICY_ constant from policy.h
+ *
+ * @return  success         new Cache
+ * @return  failure         NULL
+ */
+
+Cache createCache(long cache_size, int block_size, int write_policy, int replacement)
+{
+    Cache cache;
+    
+    /* Validate Inputs */
+    if (cache_size <= 0 || block_size <= 0 || (block_size & (block_size - 1)) != 0 ||
+        cache_size < block_size || cache_size / block_size > INT_MAX ||
+        (write_policy != 0 && write_policy != 1))
+    {
+        fprintf(stderr, "Invalid cache parameters.\n");
+        return NULL;
+    }
+
+    /* Create Cache */
+    cache = (Cache)malloc(sizeof(struct Cache_));
+    assert(cache != NULL);
+
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->reads = 0;
+    cache->writes = 0;
+    cache->splits = 0;
+    cache->cycles = 0;
+    cache->hitLatency = DEFAULT_HIT_LATENCY;
+    cache->memoryLatency = DEFAULT_MEMORY_LATENCY;
+    cache->mshrs = NULL;
+    cache->now = 0;
+    cache->dram = NULL;
+    cache->regions = NULL;
+    cache->hotMisses = NULL;
+    cache->hotWrites = NULL;
+
+    cache->write_policy = write_policy;
+
+    cache->cache_size = cache_size;
+    cache->block_size = block_size;
+    cache->numLines = (int)(cache_size / block_size);
+    cache->used = 0;
+
+    cache->offset_bits = 0;
+    while((1 << cache->offset_bits) < block_size)
+    {
+        cache->offset_bits++;
+    }
+
+    cache->lines = createLineStore(cache->numLines);
+    cache->index = createTagIndex(cache->numLines);
+    cache->bloom = NULL;
+    cache->lineOf = NULL;
+    cache->pc = 0;
+    cache->filter = NULL;
+    cache->policy = createPolicy(replacement, cache->numLines, lineTag, cache);
+
+    if (cache->lines == NULL || cache->index == NULL || cache->policy == NULL)
+    {
+        destroyCache(cache);
+        return NULL;
+    }
+
+    return cache;
+}
+
+/* destroyCache
+ * ...
+ */
+
+void destroyCache(Cache cache)
+{
+    if (cache != NULL)
+    {
+        destroyTagIndex(cache->index);
+        destroyBloomFilter(cache->bloom);
+        destroyPolicy(cache->policy);
+        destroyMshrFile(cache->mshrs);
+        free(cache->lineOf);
+        destroyLineStore(cache->lines);
+        free(cache);
+    }
+}
+
+/* readFromCache
+ * ...
+ */
+
+int readFromCache(Cache cache, char* address)
+{
+    /* Validate inputs */
+    if (cache == NULL || address == NULL)
+    {
+        fprintf(stderr, "Error: Invalid cache or memory address.\n");
+        return 0;
+    }
+
+    accessCache(cache, htoi(address), 0);
+
+    return 1;
+}
+
+/* writeToCache
+ * ...
+ */
+
+int writeToCache(Cache cache, char* address)
+{
+    /* Validate inputs */
+    if (cache == NULL || address == NULL)
+    {
+        fprintf(stderr, "Error: Invalid cache or memory address.\n");
+        return 0;
+    }
+
+    accessCache(cache, htoi(address), 1);
+
+    return 1;
+}
+
+/* findLine
+ *
+ * Returns the line holding tag, or -1 on a miss. In dense id mode the
+ * tag is a block id and the lookup is a single array read. With a Bloom
+ * filter, tags it rules out skip the index probe.
+ */
+
+static int findLine(Cache cache, unsigned long tag)
+{
+    int line;
+
+    if (cache->lineOf != NULL)
+    {
+        return cache->lineOf[tag];
+    }
+
+    if (cache->bloom != NULL)
+    {
+        if (!bloomCheck(cache->bloom, tag))
+        {
+            return -1;
+        }
+
+        line = tagIndexFind(cache->index, tag);
+        if (line == -1)
+        {
+            bloomFalsePositive(cache->bloom);
+        }
+
+        return line;
+    }
+
+    return tagIndexFind(cache->index, tag);
+}
+
+/* mapLine
+ *
+ * Records that tag now lives in line.
+ */
+
+static void mapLine(Cache cache, unsigned long tag, int line)
+{
+    if (cache->lineOf != NULL)
+    {
+        cache->lineOf[tag] = line;
+    }
+    else
+    {
+        tagIndexInsert(cache->index, tag, line);
+        if (cache->bloom != NULL)
+        {
+            bloomAdd(cache->bloom, tag);
+        }
+    }
+}
+
+/* unmapLine
+ *
+ * Forgets the line of an evicted tag.
+ */
+
+static void unmapLine(Cache cache, unsigned long tag)
+{
+    if (cache->lineOf != NULL)
+    {
+        cache->lineOf[tag] = -1;
+    }
+    else
+    {
+        tagIndexRemove(cache->index, tag);
+        if (cache->bloom != NULL)
+        {
+            bloomRemove(cache->bloom, tag);
+        }
+    }
+}
+
+/* memoryRead
+ *
+ * Fetches the block with the given tag from main memory.
+ */
+
+static void memoryRead(Cache cache, unsigned long tag)
+{
+    unsigned long issue, latency;
+
+    cache->reads++;
+
+    /* A non-blocking miss waits only for a free MSHR; a blocking one
+       is issued at the running cycle count */
+    issue = cache->cycles;
+    if (cache->mshrs != NULL)
+    {
+        issue = mshrIssue(cache->mshrs, cache->now);
+        cache->now = issue;
+    }
+
+    latency = cache->memoryLatency;
+    if (cache->dram != NULL)
+    {
+        latency = dramAccess(cache->dram, tag << cache->offset_bits,
+                             (unsigned long)cache->block_size, 0, issue);
+    }
+
+    cache->cycles += latency;
+    if (cache->mshrs != NULL)
+    {
+        mshrAllocate(cache->mshrs, tag, issue, latency);
+    }
+
+    if (cache->filter != NULL)
+    {
+        traceWrite(cache->filter, cache->pc, tag << cache->offset_bits, 0);
+    }
+}
+
+/* memoryWrite
+ *
+ * Writes the block with the given tag to main memory, either a
+ * write through store or a dirty write back.
+ */
+
+static void memoryWrite(Cache cache, unsigned long tag)
+{
+    cache->writes++;
+
+    PROFILE_BEGIN(PROFILE_STATS);
+    if (cache->regions != NULL)
+    {
+        regionWrite(cache->regions, tag << cache->offset_bits);
+    }
+
+    if (cache->hotWrites != NULL)
+    {
+        topKAdd(cache->hotWrites, tag << cache->offset_bits, 1);
+    }
+    PROFILE_END(PROFILE_STATS);
+
+    if (cache->dram != NULL)
+    {
+        dramAccess(cache->dram, tag << cache->offset_bits, (unsigned long)cache->block_size, 1,
+                   cache->mshrs != NULL ? cache->now : cache->cycles);
+    }
+
+    if (cache->filter != NULL)
+    {
+        traceWrite(cache->filter, cache->pc, tag << cache->offset_bits, 1);
+    }
+}
+
+/* accessBlock
+ *
+ * Reads or writes the block with the given tag. Shared by accessCache
+ * and accessCacheId, which only differ in how they form the tag. If
+ * held is not NULL it receives the line now holding the block.
+ */
+
+static int accessBlock(Cache cache, unsigned long tag, int write, int* held)
+{
+    unsigned long victim;
+    int line;
+
+    PROFILE_BEGIN(PROFILE_LOOKUP);
+    line = findLine(cache, tag);
+    PROFILE_END(PROFILE_LOOKUP);
+    cache->cycles += cache->hitLatency;
+
+    PROFILE_BEGIN(PROFILE_STATS);
+    if (cache->regions != NULL)
+    {
+        regionAccess(cache->regions, tag << cache->offset_bits, line != -1, 1);
+    }
+
+    if (line == -1 && cache->hotMisses != NULL)
+    {
+        topKAdd(cache->hotMisses, tag << cache->offset_bits, 1);
+    }
+    PROFILE_END(PROFILE_STATS);
+
+    /* The tag check takes the hit latency; a miss is issued after it */
+    if (cache->mshrs != NULL)
+    {
+        cache->now += cache->hitLatency;
+        mshrAdvance(cache->mshrs, cache->now);
+    }
+
+    if (line != -1)
+    {
+        cache->hits++;
+
+        if (write)
+        {
+            if (cache->write_policy == 0)
+            {
+                memoryWrite(cache, tag);
+            }
+            else
+            {
+                lineStoreSetDirty(cache->lines, line);
+            }
+        }
+
+        if (cache->mshrs != NULL)
+        {
+            mshrMerge(cache->mshrs, tag);
+        }
+
+        PROFILE_BEGIN(PROFILE_REPLACE);
+        policyHit(cache->policy, line, tag);
+        PROFILE_END(PROFILE_REPLACE);
+
+        if (held != NULL)
+        {
+            *held = line;
+        }
+        return 1;
+    }
+
+    /* Block not found, so fetch it from memory into a free line, or
+       into the line the replacement policy gives up */
+    cache->misses++;
+    memoryRead(cache, tag);
+
+    PROFILE_BEGIN(PROFILE_REPLACE);
+    if (cache->used < cache->numLines)
+    {
+        line = cache->used++;
+    }
+    else
+    {
+        line = policyVictim(cache->policy);
+        victim = lineStoreTag(cache->lines, line);
+
+        if (lineStoreDirty(cache->lines, line))
+        {
+            memoryWrite(cache, victim);
+        }
+        unmapLine(cache, victim);
+    }
+
+    lineStoreFill(cache->lines, line, tag, write && cache->write_policy == 1);
+
+    if (write && cache->write_policy == 0)
+    {
+        memoryWrite(cache, tag);
+    }
+
+    mapLine(cache, tag, line);
+    policyFill(cache->policy, line, tag);
+    PROFILE_END(PROFILE_REPLACE);
+
+    if (held != NULL)
+    {
+        *held = line;
+    }
+    return 0;
+}
+
+/* accessCache
+ * ...
+ */
+
+int accessCache(Cache cache, unsigned long address, int write)
+{
+    return accessCachePc(cache, 0, address, write);
+}
+
+/* accessCachePc
+ * ...
+ */
+
+int accessCachePc(Cache cache, unsigned long pc, unsigned long address, int write)
+{
+    cache->pc = pc;
+
+    return accessBlock(cache, address >> cache->offset_bits, write, NULL);
+}
+
+/* accessCacheSized
+ * ...
+ */
+
+int accessCacheSized(Cache cache, unsigned long pc, unsigned long address, unsigned long size, int write)
+{
+    unsigned long block, last;
+    int hit;
+
+    block = address >> cache->offset_bits;
+    last = block;
+
+    if (size > 1)
+    {
+        last = (address + size - 1 < address) ? (~0UL >> cache->offset_bits)
+                                               : (address + size - 1) >> cache->offset_bits;
+    }
+
+    if (last == block)
+    {
+        return accessCachePc(cache, pc, address, write);
+    }
+
+    cache->splits++;
+    cache->pc = pc;
+    hit = 1;
+
+    for (;;)
+    {
+        hit &= accessBlock(cache, block, write, NULL);
+
+        if (block == last)
+        {
+            break;
+        }
+        block++;
+    }
+
+    return hit;
+}
+
+/* accessCacheRun
+ * ...
+ */
+
+int accessCacheRun(Cache cache, unsigned long pc, unsigned long address, int write,
+                   unsigned long count, unsigned long writes)
+{
+    unsigned long tag, rest;
+    int hit, line;
+
+    cache->pc = pc;
+    tag = address >> cache->offset_bits;
+    hit = accessBlock(cache, tag, write, &line);
+
+    if (count <= 1)
+    {
+        return hit;
+    }
+
+    /* The block was just brought in (or found) and nothing else has
+       been accessed since, so the rest of the run hits the same line */
+    rest = writes - (unsigned long)write;
+
+    cache->hits += count - 1;
+    cache->cycles += cache->hitLatency * (count - 1);
+
+    PROFILE_BEGIN(PROFILE_STATS);
+    if (cache->regions != NULL)
+    {
+        regionAccess(cache->regions, tag << cache->offset_bits, 1, count - 1);
+    }
+    PROFILE_END(PROFILE_STATS);
+
+    if (rest > 0)
+    {
+        if (cache->write_policy == 0)
+        {
+            while (rest-- > 0)
+            {
+                memoryWrite(cache, tag);
+            }
+        }
+        else
+        {
+            lineStoreSetDirty(cache->lines, line);
+        }
+    }
+
+    PROFILE_BEGIN(PROFILE_REPLACE);
+    policyHitRun(cache->policy, line, tag, count - 1);
+    PROFILE_END(PROFILE_REPLACE);
+
+    return hit;
+}
+
+/* cacheUseDenseIds
+ * ...
+ */
+
+void cacheUseDenseIds(Cache cache, unsigned long numIds)
+{
+    unsigned long i;
+
+    assert(cache->used == 0);
+
+    free(cache->lineOf);
+    cache->lineOf = (int*)malloc(sizeof(int) * (numIds + 1));
+    assert(cache->lineOf != NULL);
+
+    for (i = 0; i < numIds; i++)
+    {
+        cache->lineOf[i] = -1;
+    }
+}
+
+/* accessCacheId
+ * ...
+ */
+
+int accessCacheId(Cache cache, unsigned long id, int write)
+{
+    return accessBlock(cache, id, write, NULL);
+}
+
+/* cacheSetLatency
+ * ...
+ */
+
+void cacheSetLatency(Cache cache, unsigned long hitLatency, unsigned long memoryLatency)
+{
+    cache->hitLatency = hitLatency;
+    cache->memoryLatency = memoryLatency;
+}
+
+/* cacheSetMshrs
+ * ...
+ */
+
+int cacheSetMshrs(Cache cache, int entries)
+{
+    MshrFile mshrs;
+
+    mshrs = createMshrFile(entries);
+    if (mshrs == NULL)
+    {
+        return 0;
+    }
+
+    destroyMshrFile(cache->mshrs);
+    cache->mshrs = mshrs;
+    cache->now = 0;
+
+    return 1;
+}
+
+/* cacheMshrStats
+ * ...
+ */
+
+void cacheMshrStats(Cache cache, MshrStats* stats)
+{
+    mshrGetStats(cache->mshrs, stats);
+    mshrAdvance(cache->mshrs, stats->last > cache->now ? stats->last : cache->now);
+    mshrGetStats(cache->mshrs, stats);
+}
+
+/* cacheSetDram
+ * ...
+ */
+
+void cacheSetDram(Cache cache, Dram dram)
+{
+    cache->dram = dram;
+}
+
+/* cacheSetRegions
+ * ...
+ */
+
+void cacheSetRegions(Cache cache, RegionTable table)
+{
+    cache->regions = table;
+}
+
+/* cacheSetHotBlocks
+ * ...
+ */
+
+void cacheSetHotBlocks(Cache cache, TopK misses, TopK writes)
+{
+    cache->hotMisses = misses;
+    cache->hotWrites = writes;
+}
+
+/* cacheSetFilter
+ * ...
+ */
+
+void cacheSetFilter(Cache cache, TraceWriter filter)
+{
+    cache->filter = filter;
+}
+
+/* cacheSetBloom
+ * ...
+ */
+
+int cacheSetBloom(Cache cache, int counters)
+{
+    BloomFilter bloom;
+
+    bloom = createBloomFilter(cache->numLines, counters);
+    if (bloom == NULL)
+    {
+        return 0;
+    }
+
+    destroyBloomFilter(cache->bloom);
+    cache->bloom = bloom;
+
+    return 1;
+}
+
+/* cacheBloomStats
+ * ...
+ */
+
+void cacheBloomStats(Cache cache, BloomStats* stats)
+{
+    bloomGetStats(cache->bloom, stats);
+}
+
+/* cacheSetCompact
+ * ...
+ */
+
+int cacheSetCompact(Cache cache)
+{
+    TagIndex index;
+
+    assert(cache->used == 0);
+
+    index = createCompactTagIndex(cache->numLines, lineTag, cache);
+    if (index == NULL)
+    {
+        return 0;
+    }
+
+    destroyTagIndex(cache->index);
+    cache->index = index;
+
+    return 1;
+}
+
+/* printCache
+ * ...
+ */
+
+void printCache(Cache cache)
+{
+    int i;
+
+    if (cache != NULL)
+    {
+        for (i = 0; i < cache->numLines; i++)
+        {
+            printf("[%i]: { valid: %i, tag: 0x%lx }\n", i, i < cache->used, lineStoreTag(cache->lines, i));
+        }
+
+        printf("Cache:\n\tCACHE HITS: %lu\n\tCACHE MISSES: %lu\n\tREADS: %lu\n\tWRITES: %lu\n\n", cache->hits, cache->misses, cache->reads, cache->writes);
+    }
+}
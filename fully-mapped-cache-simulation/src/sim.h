@@ -7,18 +7,92 @@
  * This is a program that simulates a cache using a trace file 
  * and either a write through or write back policy.
  * 
- * Usage: Usage: ./sim [-h] <write policy> <trace file>
+ * Usage: Usage: ./sim [-h] [options] <write policy> <trace file>
+ *        ./sim object [--policy lru|gdsf] <capacity> <trace file>
+ *        ./sim remap [--block-size <bytes>] <trace file> <id trace file>
+ *        ./sim stats [--approx] <trace file>
+ *        ./sim index [--every <n>] <trace file> [<index file>]
  *
  * <write policy> is one of:
  *      wt - simulate a write through cache.
  *      wb - simulate a write back cache
  *
- * <trace file> is the name of a file that contains a memory access trace.
+ * <trace file> is the name of a file that contains a memory access trace,
+ * or an id trace written by ./sim remap. A text or binary trace can
+ * also come from standard input (given as -) or a named pipe, and is
+ * then processed as it arrives.
+ *
+ * [options] are:
+ *      --policy <name>     replacement policy: lru (default), fifo,
+ *                          random, lfu, tinylfu or clock. See policy.h.
+ *      --filter <file>     write the miss and writeback stream to file
+ *      --filter-format <f> format of the filtered trace: text (default)
+ *                          or binary. See trace.h.
+ *      --format <f>        format of the results: text (default), json
+ *                          or csv. See report.h.
+ *      --cache-size <n>    data cache size in bytes (default CACHE_SIZE)
+ *      --block-size <n>    data cache block size in bytes (default
+ *                          BLOCK_SIZE)
+ *      --icache <n>        model a separate instruction cache of n bytes,
+ *                          fed by the fetch records of a Lackey trace or
+ *                          else by the pc of every access
+ *      --icache-block <n>  instruction cache block size in bytes
+ *      --unified           send instruction fetches to the data cache
+ *      --hit-latency <n>   cycles per cache access (reports the AMAT)
+ *      --icache-latency <n> cycles per instruction cache access
+ *      --memory-latency <n> extra cycles per miss
+ *      --mshrs <n>         time the data cache as non-blocking with n miss
+ *                          status holding registers (see mshr.h)
+ *      --dram              put a DRAM model behind the data cache (see
+ *                          dram.h), configured with --dram-channels <n>,
+ *                          --dram-banks <n>, --dram-row <bytes> and
+ *                          --dram-page open|closed
+ *      --tlb               model a DTLB and STLB in front of the data
+ *                          cache (see tlb.h), sized with --dtlb <n> and
+ *                          --stlb <n> entries (0 for no STLB)
+ *      --page-size <n>     page size in bytes for --tlb and --translate,
+ *                          e.g. 4K, 2M or 1G (default 4K)
+ *      --page-walk         send page walk reads through the data cache
+ *      --translate <a>     send physical addresses to the caches, mapped
+ *                          by allocator a: identity, random, color or
+ *                          huge (see pagemap.h)
+ *      --phys-mem <n>      physical memory in bytes for --translate
+ *                          (default 4G)
+ *      --colors <n>        page colors for --translate color (default 64)
+ *      --regions           report hits, misses and memory writes per
+ *                          address region, inferred from the trace
+ *      --region <n:lo-hi>  add a region (repeatable; see region.h)
+ *      --hot <k>           report the k blocks with the most misses and
+ *                          the most memory writes (see topk.h), counted
+ *                          with --hot-counters <n> counters or exactly
+ *                          with --hot-exact
+ *      --bloom             check a counting Bloom filter before the tag
+ *                          index (see bloom.h), with --bloom-counters <n>
+ *                          counters per cache line
+ *      --compact           index tags by fingerprint and read them back
+ *                          from the line state, for caches too large for
+ *                          the full tag index (see tagindex.h)
+ *      --core              model an in-order core: one cycle per
+ *                          instruction plus a stall for every cycle an
+ *                          access takes beyond a hit
+ *      --collapse          apply runs of accesses to the same block in
+ *                          one step
+ *      --start <k>         start at access k, seeking through
+ *                          <trace file>.idx if present (see traceindex.h)
+ *      --count <n>         simulate at most n accesses
+ *      --interval <n>      print the counters every n accesses
  */
  
 #ifndef SWIFT_SIM_H_
 #define SWIFT_SIM_H_
 
+#include "tracewriter.h"
+#include "mshr.h"
+#include "dram.h"
+#include "region.h"
+#include "topk.h"
+#include "bloom.h"
+
 /* Constants 
  *
  * Both CACHE_SIZE and BLOCK_SIZE are in bytes. We can calculate the number 
@@ -37,7 +111,19 @@
 #define CACHE_SIZE 16384
 #define BLOCK_SIZE 4
 
-/* Block Sizes */
+/* Largest --cache-size; the line count must also fit in an int */
+#define CACHE_SIZE_MAX (1L << 40)
+
+/* Latency Model Defaults (cycles) */
+#define DEFAULT_HIT_LATENCY 1
+#define DEFAULT_MEMORY_LATENCY 100
+
+/* Block Sizes
+ *
+ * These describe the direct mapped split of an address and are only
+ * used by the debugging helpers. The fully associative cache uses the
+ * whole block address (address / BLOCK_SIZE) as its tag.
+ */
 #define TAG 18 /* 18 + 0 = 18 */
 #define INDEX 12 /* 18 + 12 = 30 */
 #define OFFSET 2 /* 30 + 2 = 32 */
@@ -45,7 +131,6 @@
 
 /* Typedefs */
 typedef struct Cache_* Cache;
-typedef struct Block_* Block;
 
 
 /* createCache
@@ -53,15 +138,16 @@ typedef struct Block_* Block;
  * Function to create a new cache struct.  Returns the new struct on success
  * and NULL on failure.
  *
- * @param   cache_size      size of cache in bytes
- * @param   block_size      size of each block in bytes
+ * @param   cache_size      size of cache in bytes, at most INT_MAX lines
+ * @param   block_size      size of each block in bytes (a power of two)
  * @param   write_policy    0 = write through, 1 = write back
+ * @param   replacement     POLICY_ constant from policy.h
  *
  * @return  success         new Cache
  * @return  failure         NULL
  */
  
-Cache createCache(int cache_size, int block_size, int write_policy);
+Cache createCache(long cache_size, int block_size, int write_policy, int replacement);
 
 /* destroyCache
  * 
@@ -105,6 +191,267 @@ int readFromCache(Cache cache, char* address);
 
 int writeToCache(Cache cache, char* address);
 
+/* accessCache
+ *
+ * Function that reads or writes a numeric address. This is what
+ * readFromCache and writeToCache call once the address is parsed.
+ * On a miss with every line in use, the replacement policy picks the
+ * block to evict; dirty victims are written back under write back.
+ *
+ * @param       cache       target cache struct
+ * @param       address     byte address
+ * @param       write       0 = read, 1 = write
+ *
+ * @return      hit         1
+ * @return      miss        0
+ */
+
+int accessCache(Cache cache, unsigned long address, int write);
+
+/* accessCachePc
+ *
+ * Like accessCache, but also gives the PC of the instruction making the
+ * access. The PC is carried into the filtered trace (cacheSetFilter).
+ *
+ * @param       cache       target cache struct
+ * @param       pc          instruction address
+ * @param       address     byte address
+ * @param       write       0 = read, 1 = write
+ *
+ * @return      hit         1
+ * @return      miss        0
+ */
+
+int accessCachePc(Cache cache, unsigned long pc, unsigned long address, int write);
+
+/* accessCacheSized
+ *
+ * Simulates an access of size bytes at address, which touches every
+ * block from the one holding address to the one holding its last byte.
+ * Each block is accessed in turn; an access covering more than one is
+ * counted as a split access. A size of 0 (unknown) or 1 touches one
+ * block.
+ *
+ * @param       cache       target cache struct
+ * @param       pc          address of the instruction making the access
+ * @param       address     byte address of the first byte accessed
+ * @param       size        number of bytes accessed
+ * @param       write       0 = read, 1 = write
+ *
+ * @return      hit         1 (every block hit)
+ * @return      miss        0
+ */
+
+int accessCacheSized(Cache cache, unsigned long pc, unsigned long address, unsigned long size, int write);
+
+/* accessCacheRun
+ *
+ * Applies a run of count consecutive accesses to the same block in one
+ * step (see readTraceRun in trace.h). The first access is simulated
+ * normally; the remaining count - 1 are all hits, and any writes among
+ * them dirty the block (write back) or each go to memory (write
+ * through). Counters and replacement state end up exactly as if the
+ * accesses had been simulated one by one.
+ *
+ * @param       cache       target cache struct
+ * @param       pc          pc of the first access
+ * @param       address     byte address of the first access
+ * @param       write       0 = first access is a read, 1 = a write
+ * @param       count       number of accesses in the run
+ * @param       writes      number of writes in the run, including the first
+ *
+ * @return      hit         1 (first access hit)
+ * @return      miss        0
+ */
+
+int accessCacheRun(Cache cache, unsigned long pc, unsigned long address, int write,
+                   unsigned long count, unsigned long writes);
+
+/* cacheUseDenseIds
+ *
+ * Switches an empty cache to dense id mode: from now on it is driven by
+ * accessCacheId with block ids 0 to numIds - 1 (see remap.h), and finds
+ * blocks through an array indexed by id instead of the tag index.
+ *
+ * @param       cache       target cache struct, not yet accessed
+ * @param       numIds      number of distinct block ids
+ *
+ * @return      void
+ */
+
+void cacheUseDenseIds(Cache cache, unsigned long numIds);
+
+/* accessCacheId
+ *
+ * Like accessCache, but for a cache in dense id mode.
+ *
+ * @param       cache       target cache struct
+ * @param       id          dense block id
+ * @param       write       0 = read, 1 = write
+ *
+ * @return      hit         1
+ * @return      miss        0
+ */
+
+int accessCacheId(Cache cache, unsigned long id, int write);
+
+/* cacheSetLatency
+ *
+ * Sets the latencies the cache charges: every access costs hitLatency
+ * cycles and every fill from memory memoryLatency more. The total is
+ * kept as a running sum, so the average memory access time is that sum
+ * over hits + misses. Writes to memory are taken to be absorbed by a
+ * write buffer and cost nothing.
+ *
+ * @param       cache           target cache struct
+ * @param       hitLatency      cycles per access
+ * @param       memoryLatency   extra cycles per miss
+ *
+ * @return      void
+ */
+
+void cacheSetLatency(Cache cache, unsigned long hitLatency, unsigned long memoryLatency);
+
+/* cacheSetMshrs
+ *
+ * Makes the cache non-blocking for timing with the given number of miss
+ * status holding registers (see mshr.h). The cache then keeps a clock:
+ * every access advances it by the hit latency, a miss takes a register
+ * for the memory latency without stopping the clock, and only a miss
+ * that finds every register busy stalls it. Hit and miss counts are not
+ * affected. Runs given to accessCacheRun are not timed this way.
+ * Returns 1 on success and 0 on failure.
+ *
+ * @param       cache       target cache struct, not yet accessed
+ * @param       entries     number of registers
+ *
+ * @return      success     1
+ * @return      failure     0
+ */
+
+int cacheSetMshrs(Cache cache, int entries);
+
+/* cacheMshrStats
+ *
+ * Lets every outstanding miss return and copies out the register
+ * counters of a cache set up with cacheSetMshrs.
+ *
+ * @param       cache       target cache struct
+ * @param       stats       filled with the counters
+ *
+ * @return      void
+ */
+
+void cacheMshrStats(Cache cache, MshrStats* stats);
+
+/* cacheSetDram
+ *
+ * Puts a DRAM model (see dram.h) behind the cache. Every fill is then a
+ * DRAM read whose latency replaces the memory latency, and every write
+ * to memory a DRAM write, which is not charged to the access. Requests
+ * are timed by the cache's clock: the running cycle count, or the
+ * non-blocking clock with cacheSetMshrs. The DRAM is not freed with the
+ * cache. Pass NULL to go back to a fixed memory latency. Not available
+ * in dense id mode.
+ *
+ * @param       cache       target cache struct
+ * @param       dram        DRAM model, or NULL
+ *
+ * @return      void
+ */
+
+void cacheSetDram(Cache cache, Dram dram);
+
+/* cacheSetRegions
+ *
+ * Counts every block access and memory write against the region of
+ * table holding the block (see region.h). The table is not freed with
+ * the cache. Pass NULL to stop. Not available in dense id mode.
+ *
+ * @param       cache       target cache struct
+ * @param       table       region table, or NULL
+ *
+ * @return      void
+ */
+
+void cacheSetRegions(Cache cache, RegionTable table);
+
+/* cacheSetHotBlocks
+ *
+ * Counts the misses and the memory writes of every block, by block
+ * address, in two top-k counters (see topk.h). The counters are not
+ * freed with the cache. Pass NULL to stop. Not available in dense id
+ * mode.
+ *
+ * @param       cache       target cache struct
+ * @param       misses      counter of misses, or NULL
+ * @param       writes      counter of memory writes, or NULL
+ *
+ * @return      void
+ */
+
+void cacheSetHotBlocks(Cache cache, TopK misses, TopK writes);
+
+/* cacheSetFilter
+ *
+ * Makes the cache act as a filter: every block fetched from memory is
+ * written to filter as a read, and every write to memory (write through
+ * stores and dirty write backs) as a write, each with the PC of the
+ * access that caused it. The result is the trace the next level of the
+ * hierarchy would see. Pass NULL to stop. Not available in dense id
+ * mode, where the cache only sees block ids.
+ *
+ * @param       cache       target cache struct
+ * @param       filter      trace writer, or NULL
+ *
+ * @return      void
+ */
+
+void cacheSetFilter(Cache cache, TraceWriter filter);
+
+/* cacheSetBloom
+ *
+ * Puts a counting Bloom filter (see bloom.h) in front of the tag index.
+ * Lookups it rules out are misses without an index probe; hit and miss
+ * counts are not affected. Returns 1 on success and 0 on failure. Not
+ * used in dense id mode, whose lookups are already an array read.
+ *
+ * @param       cache       target cache struct, not yet accessed
+ * @param       counters    filter counters per cache line
+ *
+ * @return      success     1
+ * @return      failure     0
+ */
+
+int cacheSetBloom(Cache cache, int counters);
+
+/* cacheBloomStats
+ *
+ * Copies out the filter counters of a cache set up with cacheSetBloom.
+ *
+ * @param       cache       target cache struct
+ * @param       stats       filled with the counters
+ *
+ * @return      void
+ */
+
+void cacheBloomStats(Cache cache, BloomStats* stats);
+
+/* cacheSetCompact
+ *
+ * Switches the cache to a compact tag index (see tagindex.h) that keeps
+ * a fingerprint per line and reads tags back from the line state, for
+ * caches whose full index would not fit in memory. Lookups cost more;
+ * results are unchanged. Returns 1 on success and 0 on failure.
+ *
+ * @param       cache       target cache struct, not yet accessed
+ *
+ * @return      success     1
+ * @return      failure     0
+ */
+
+int cacheSetCompact(Cache cache);
+
 /* printCache
  *
  * Prints out the values of each slot in the cache
@@ -0,0 +1,218 @@
+/* File: sketch.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Cache line blocked count-min sketch. See sketch.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -Sketch
+ *      3. Utility Functions
+ *          -mixKey
+ *          -halveSketch
+ *      4. Sketch Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include "sketch.h"
+
+/* Words per 64 byte block. Each word holds sixteen 4 bit counters and
+   each of the four rows owns two words of every block. */
+#define SKETCH_BLOCK_WORDS 8
+#define SKETCH_DEPTH 4
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* Sketch
+ *
+ * @param   memory          pointer returned by malloc
+ * @param   table           64 byte aligned counter blocks
+ * @param   blockMask       number of blocks - 1 (a power of two)
+ * @param   additions       increments since the last halving
+ * @param   sampleSize      increments between halvings
+ */
+
+struct Sketch_ {
+    void* memory;
+    uint64_t* table;
+    unsigned long blockMask;
+    unsigned long additions;
+    unsigned long sampleSize;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* mixKey
+ *
+ * 64 bit finalizer so that block tags, which only differ in their low
+ * bits, spread over the whole table.
+ */
+
+static uint64_t mixKey(unsigned long key)
+{
+    uint64_t h;
+
+    h = (uint64_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdUL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53UL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+/* halveSketch
+ *
+ * Divides every counter by two. Shifting a whole word moves the low bit
+ * of each counter into the high bit of its neighbour, so those bits are
+ * masked off.
+ */
+
+static void halveSketch(Sketch sketch)
+{
+    unsigned long i, words;
+
+    words = (sketch->blockMask + 1) * SKETCH_BLOCK_WORDS;
+
+    for(i = 0; i < words; i++)
+    {
+        sketch->table[i] = (sketch->table[i] >> 1) & 0x7777777777777777UL;
+    }
+
+    sketch->additions = sketch->additions / 2;
+}
+
+/********************************
+ *     4. Sketch Functions      *
+ ********************************/
+
+/* createSketch
+ * ...
+ */
+
+Sketch createSketch(int capacity)
+{
+    Sketch sketch;
+    unsigned long blocks, bytes;
+
+    if(capacity <= 0)
+    {
+        fprintf(stderr, "Invalid sketch capacity.\n");
+        return NULL;
+    }
+
+    /* About four counters per row for every cache entry */
+    blocks = 1;
+    while(blocks * 8 < (unsigned long)capacity)
+    {
+        blocks = blocks * 2;
+    }
+
+    sketch = (Sketch)malloc(sizeof(struct Sketch_));
+    assert(sketch != NULL);
+
+    bytes = blocks * SKETCH_BLOCK_WORDS * sizeof(uint64_t);
+
+    sketch->memory = calloc(1, bytes + 64);
+    assert(sketch->memory != NULL);
+
+    sketch->table = (uint64_t*)(((uintptr_t)sketch->memory + 63) & ~(uintptr_t)63);
+    sketch->blockMask = blocks - 1;
+    sketch->additions = 0;
+    sketch->sampleSize = 10 * (unsigned long)capacity;
+
+    return sketch;
+}
+
+/* destroySketch
+ * ...
+ */
+
+void destroySketch(Sketch sketch)
+{
+    if(sketch != NULL)
+    {
+        free(sketch->memory);
+        free(sketch);
+    }
+}
+
+/* sketchIncrement
+ * ...
+ */
+
+int sketchIncrement(Sketch sketch, unsigned long key)
+{
+    uint64_t h, *block, mask;
+    int i, shift, added;
+
+    h = mixKey(key);
+    block = sketch->table + (h & sketch->blockMask) * SKETCH_BLOCK_WORDS;
+    added = 0;
+
+    for(i = 0; i < SKETCH_DEPTH; i++)
+    {
+        /* Bit 32 + i picks one of the row's two words, the next nibble of
+           the hash picks the counter inside it */
+        shift = (int)((h >> (40 + 4 * i)) & 15) * 4;
+        mask = (uint64_t)15 << shift;
+
+        if((block[2 * i + ((h >> (32 + i)) & 1)] & mask) != mask)
+        {
+            block[2 * i + ((h >> (32 + i)) & 1)] += (uint64_t)1 << shift;
+            added = 1;
+        }
+    }
+
+    if(added)
+    {
+        sketch->additions++;
+
+        if(sketch->additions >= sketch->sampleSize)
+        {
+            halveSketch(sketch);
+        }
+    }
+
+    return added;
+}
+
+/* sketchEstimate
+ * ...
+ */
+
+int sketchEstimate(Sketch sketch, unsigned long key)
+{
+    uint64_t h, *block;
+    int i, shift, count, min;
+
+    h = mixKey(key);
+    block = sketch->table + (h & sketch->blockMask) * SKETCH_BLOCK_WORDS;
+    min = 15;
+
+    for(i = 0; i < SKETCH_DEPTH; i++)
+    {
+        shift = (int)((h >> (40 + 4 * i)) & 15) * 4;
+        count = (int)((block[2 * i + ((h >> (32 + i)) & 1)] >> shift) & 15);
+
+        if(count < min)
+        {
+            min = count;
+        }
+    }
+
+    return min;
+}
@@ -0,0 +1,76 @@
+/* File: sketch.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * A count-min sketch of 4 bit counters used as the TinyLFU admission
+ * filter. Counters are grouped into 64 byte blocks; a key hashes to one
+ * block and all four of its counters live inside it, so every increment
+ * or estimate touches exactly one cache line of the table.
+ *
+ * Once the number of increments reaches ten times the cache capacity
+ * every counter is halved, so the sketch tracks recent popularity rather
+ * than all time counts.
+ */
+
+#ifndef SWIFT_SKETCH_H_
+#define SWIFT_SKETCH_H_
+
+/* Typedefs */
+typedef struct Sketch_* Sketch;
+
+
+/* createSketch
+ *
+ * Function to create a sketch sized for a cache holding capacity
+ * entries. Returns the new sketch on success and NULL on failure.
+ *
+ * @param   capacity        number of entries in the cache
+ *
+ * @return  success         new Sketch
+ * @return  failure         NULL
+ */
+
+Sketch createSketch(int capacity);
+
+/* destroySketch
+ *
+ * Frees all memory held by the sketch. Passing NULL does nothing.
+ *
+ * @param   sketch          sketch to be destroyed
+ *
+ * @return  void
+ */
+
+void destroySketch(Sketch sketch);
+
+/* sketchIncrement
+ *
+ * Records one occurrence of key, halving the whole sketch if the
+ * sample period has been reached. Once all of key's counters are
+ * saturated an increment changes nothing, and keeps changing nothing
+ * until some other key's increment halves the sketch.
+ *
+ * @param   sketch          target sketch
+ * @param   key             key to count
+ *
+ * @return  changed         1
+ * @return  saturated       0
+ */
+
+int sketchIncrement(Sketch sketch, unsigned long key);
+
+/* sketchEstimate
+ *
+ * Returns the estimated recent frequency of key (0 to 15).
+ *
+ * @param   sketch          target sketch
+ * @param   key             key to look up
+ *
+ * @return  int             estimated frequency
+ */
+
+int sketchEstimate(Sketch sketch, unsigned long key);
+
+
+#endif
+/* SWIFT_SKETCH_H_ */
@@ -0,0 +1,366 @@
+/* File: stats.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Trace statistics. See stats.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -Counter
+ *      3. Counter Functions
+ *          -createCounter
+ *          -destroyCounter
+ *          -counterAdd
+ *      4. Utility Functions
+ *          -strideBucket
+ *          -compareKeys
+ *      5. Stats Functions
+ *          -traceStats
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "stats.h"
+#include "trace.h"
+#include "tagindex.h"
+#include "hll.h"
+
+/* Block sizes the footprint is measured at */
+#define STATS_GRANULARITIES 4
+
+static const int granularity[STATS_GRANULARITIES] = { 4, 16, 64, 4096 };
+static const int granularityBits[STATS_GRANULARITIES] = { 2, 4, 6, 12 };
+
+/* Address region size for the histogram (16MB) */
+#define REGION_BITS 24
+
+/* HyperLogLog precision for --approx */
+#define STATS_HLL_PRECISION 14
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* Counter
+ *
+ * Exact count of each distinct key seen. Keys live in a table that
+ * doubles when full, and the tag index over it is rebuilt at the same
+ * time so it never gets more than half full.
+ *
+ * @param   index           key to slot in keys
+ * @param   keys            distinct keys in order of first use
+ * @param   counts          number of times each key was added
+ * @param   size            number of distinct keys
+ * @param   capacity        slots in keys and counts
+ */
+
+typedef struct Counter_ {
+    TagIndex index;
+    unsigned long* keys;
+    unsigned long* counts;
+    unsigned long size;
+    unsigned long capacity;
+} Counter;
+
+/********************************
+ *    3. Counter Functions      *
+ ********************************/
+
+/* createCounter
+ *
+ * Initializes an empty counter.
+ */
+
+static void createCounter(Counter* counter)
+{
+    counter->capacity = 1024;
+    counter->size = 0;
+    counter->keys = (unsigned long*)malloc(sizeof(unsigned long) * counter->capacity);
+    counter->counts = (unsigned long*)malloc(sizeof(unsigned long) * counter->capacity);
+    assert(counter->keys != NULL && counter->counts != NULL);
+    counter->index = createTagIndex((int)counter->capacity);
+}
+
+/* destroyCounter
+ *
+ * Frees the counter's memory.
+ */
+
+static void destroyCounter(Counter* counter)
+{
+    destroyTagIndex(counter->index);
+    free(counter->keys);
+    free(counter->counts);
+}
+
+/* counterAdd
+ *
+ * Counts one occurrence of key.
+ */
+
+static void counterAdd(Counter* counter, unsigned long key)
+{
+    int slot;
+    unsigned long i;
+
+    slot = tagIndexFind(counter->index, key);
+
+    if(slot != -1)
+    {
+        counter->counts[slot]++;
+        return;
+    }
+
+    if(counter->size == counter->capacity)
+    {
+        counter->capacity = counter->capacity * 2;
+        counter->keys = (unsigned long*)realloc(counter->keys, sizeof(unsigned long) * counter->capacity);
+        counter->counts = (unsigned long*)realloc(counter->counts, sizeof(unsigned long) * counter->capacity);
+        assert(counter->keys != NULL && counter->counts != NULL);
+
+        destroyTagIndex(counter->index);
+        counter->index = createTagIndex((int)counter->capacity);
+        for(i = 0; i < counter->size; i++)
+        {
+            tagIndexInsert(counter->index, counter->keys[i], (int)i);
+        }
+    }
+
+    counter->keys[counter->size] = key;
+    counter->counts[counter->size] = 1;
+    tagIndexInsert(counter->index, key, (int)counter->size);
+    counter->size++;
+}
+
+/********************************
+ *     4. Utility Functions     *
+ ********************************/
+
+/* strideBucket
+ *
+ * Buckets the stride between two addresses. Bucket 64 is a zero
+ * stride; 65 + k holds forward strides in [2^k, 2^(k+1)) and 63 - k
+ * the matching backward strides.
+ */
+
+static int strideBucket(unsigned long from, unsigned long to)
+{
+    unsigned long magnitude;
+    int k;
+
+    if(to == from)
+    {
+        return 64;
+    }
+
+    magnitude = (to > from) ? to - from : from - to;
+    k = 0;
+
+    while(magnitude > 1)
+    {
+        magnitude = magnitude >> 1;
+        k++;
+    }
+
+    return (to > from) ? 65 + k : 63 - k;
+}
+
+/* compareKeys
+ *
+ * qsort comparison for region numbers.
+ */
+
+static int compareKeys(const void* a, const void* b)
+{
+    unsigned long x, y;
+
+    x = *(const unsigned long*)a;
+    y = *(const unsigned long*)b;
+
+    return (x > y) - (x < y);
+}
+
+/********************************
+ *      5. Stats Functions      *
+ ********************************/
+
+/* traceStats
+ * ...
+ */
+
+int traceStats(const char* path, int approx)
+{
+    TraceReader reader;
+    Access access;
+    Counter blocks[STATS_GRANULARITIES], pcs, regions;
+    Hll blockHll[STATS_GRANULARITIES], pcHll;
+    unsigned long accesses, writes, strides[130], previous, *order;
+    unsigned long distinct, i, slot;
+    int g, status, b;
+
+    reader = openTrace(path);
+    if(reader == NULL)
+    {
+        fprintf(stderr, "Error: Could not open file.\n");
+        return 0;
+    }
+
+    for(g = 0; g < STATS_GRANULARITIES; g++)
+    {
+        if(approx)
+        {
+            blockHll[g] = createHll(STATS_HLL_PRECISION);
+        }
+        else
+        {
+            createCounter(&blocks[g]);
+        }
+    }
+
+    if(approx)
+    {
+        pcHll = createHll(STATS_HLL_PRECISION);
+    }
+    else
+    {
+        createCounter(&pcs);
+    }
+
+    createCounter(&regions);
+
+    for(b = 0; b < 130; b++)
+    {
+        strides[b] = 0;
+    }
+
+    accesses = 0;
+    writes = 0;
+    previous = 0;
+
+    while((status = readTrace(reader, &access)) == 1)
+    {
+        for(g = 0; g < STATS_GRANULARITIES; g++)
+        {
+            if(approx)
+            {
+                hllAdd(blockHll[g], access.address >> granularityBits[g]);
+            }
+            else
+            {
+                counterAdd(&blocks[g], access.address >> granularityBits[g]);
+            }
+        }
+
+        if(approx)
+        {
+            hllAdd(pcHll, access.pc);
+        }
+        else
+        {
+            counterAdd(&pcs, access.pc);
+        }
+
+        counterAdd(&regions, access.address >> REGION_BITS);
+
+        if(accesses > 0)
+        {
+            strides[strideBucket(previous, access.address)]++;
+        }
+
+        previous = access.address;
+        writes += (unsigned long)access.write;
+        accesses++;
+    }
+
+    if(status == -1)
+    {
+        printf("%lu: ERROR!!!!\n", accesses);
+    }
+    else
+    {
+        printf("ACCESSES: %lu\nREADS: %lu\nWRITES: %lu\n", accesses, accesses - writes, writes);
+        printf("READ/WRITE RATIO: %.3f\n", writes ? (double)(accesses - writes) / (double)writes : 0.0);
+
+        for(g = 0; g < STATS_GRANULARITIES; g++)
+        {
+            distinct = approx ? hllEstimate(blockHll[g]) : blocks[g].size;
+            printf("DISTINCT BLOCKS (%iB)%s: %lu\n", granularity[g], approx ? " ~" : "", distinct);
+            printf("FOOTPRINT (%iB BLOCKS)%s: %lu\n", granularity[g], approx ? " ~" : "", distinct * (unsigned long)granularity[g]);
+        }
+
+        printf("DISTINCT PCS%s: %lu\n", approx ? " ~" : "", approx ? hllEstimate(pcHll) : pcs.size);
+
+        /* Regions in address order */
+        order = (unsigned long*)malloc(sizeof(unsigned long) * (regions.size + 1));
+        assert(order != NULL);
+
+        for(i = 0; i < regions.size; i++)
+        {
+            order[i] = regions.keys[i];
+        }
+        qsort(order, regions.size, sizeof(unsigned long), compareKeys);
+
+        printf("ADDRESS REGIONS (16MB):\n");
+        for(i = 0; i < regions.size; i++)
+        {
+            slot = (unsigned long)tagIndexFind(regions.index, order[i]);
+            printf("\t0x%08lx-0x%08lx: %lu\n", order[i] << REGION_BITS,
+                   ((order[i] + 1) << REGION_BITS) - 1, regions.counts[slot]);
+        }
+        free(order);
+
+        printf("STRIDES:\n");
+        for(b = 0; b < 130; b++)
+        {
+            if(strides[b] == 0)
+            {
+                continue;
+            }
+
+            if(b == 64)
+            {
+                printf("\t0: %lu\n", strides[b]);
+            }
+            else if(b > 64)
+            {
+                printf("\t+[%lu, %lu): %lu\n", 1UL << (b - 65), (b - 65 < 63) ? 2UL << (b - 65) : 0UL, strides[b]);
+            }
+            else
+            {
+                printf("\t-[%lu, %lu): %lu\n", 1UL << (63 - b), (63 - b < 63) ? 2UL << (63 - b) : 0UL, strides[b]);
+            }
+        }
+    }
+
+    for(g = 0; g < STATS_GRANULARITIES; g++)
+    {
+        if(approx)
+        {
+            destroyHll(blockHll[g]);
+        }
+        else
+        {
+            destroyCounter(&blocks[g]);
+        }
+    }
+
+    if(approx)
+    {
+        destroyHll(pcHll);
+    }
+    else
+    {
+        destroyCounter(&pcs);
+    }
+
+    destroyCounter(&regions);
+    closeTrace(reader);
+
+    return (status == 0);
+}
@@ -0,0 +1,40 @@
+/* File: stats.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Trace statistics: ./sim stats [--approx] <trace file>. Makes one
+ * streaming pass over a trace and reports
+ *
+ *      - the number of accesses, reads and writes
+ *      - the number of distinct blocks at 4, 16, 64 and 4096 byte
+ *        block sizes, i.e. the footprint at each granularity
+ *      - the number of distinct PCs
+ *      - how accesses are spread over 16MB address regions
+ *      - the distribution of strides between consecutive accesses,
+ *        bucketed by sign and power of two
+ *
+ * Distinct counts are exact (hash sets) by default. With --approx they
+ * come from HyperLogLog estimators instead, which keeps memory constant
+ * for traces with huge footprints.
+ */
+
+#ifndef SWIFT_STATS_H_
+#define SWIFT_STATS_H_
+
+
+/* traceStats
+ *
+ * Prints statistics for a trace. Returns 1 on success and 0 on failure.
+ *
+ * @param   path            trace file name
+ * @param   approx          0 = exact distinct counts, 1 = HyperLogLog
+ *
+ * @return  success         1
+ * @return  failure         0
+ */
+
+int traceStats(const char* path, int approx);
+
+
+#endif
+/* SWIFT_STATS_H_ */
@@ -0,0 +1,750 @@
+/* File: tagindex.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Bucketized cuckoo tag index. See tagindex.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -TagBucket
+ *          -TagIndex
+ *      3. Utility Functions
+ *          -mixFirst
+ *          -mixSecond
+ *          -hashFirst
+ *          -hashSecond
+ *          -bucketMatches
+ *          -bucketFind
+ *          -bucketFree
+ *          -allocateBuckets
+ *          -hashedPlace
+ *          -growTagIndex
+ *      4. Compact Functions
+ *          -compactKey
+ *          -compactBucket
+ *          -compactMatches
+ *          -compactFree
+ *          -compactFind
+ *          -allocateCompact
+ *          -compactPlace
+ *          -growCompact
+ *      5. TagIndex Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include "tagindex.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Slots per bucket */
+#define TAGINDEX_SLOTS 4
+
+/* Slots per compact bucket, also one cache line */
+#define TAGINDEX_COMPACT_SLOTS 8
+
+/* Displacements tried before the table is grown */
+#define TAGINDEX_KICKS 128
+
+/* Bucket alignment, one cache line */
+#define TAGINDEX_ALIGN 64
+
+/* Tags an index is first sized for; it grows from there as needed */
+#define TAGINDEX_INITIAL 1024
+
+/* Lowest slot set in a match mask, -1 for none */
+static const int slotOf[1 << TAGINDEX_SLOTS] = { -1, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0 };
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* TagBucket
+ *
+ * Tags first so a bucket compares with two 16 byte loads. With 64 bit
+ * tags the padding makes a bucket exactly one cache line.
+ *
+ * @param   tags            tag stored in each slot
+ * @param   lines           line stored in each slot (-1 = empty)
+ */
+
+typedef struct {
+    unsigned long tags[TAGINDEX_SLOTS];
+    int lines[TAGINDEX_SLOTS];
+    int pad[TAGINDEX_SLOTS];
+} TagBucket;
+
+/* TagIndex
+ *
+ * A full index uses buckets. A compact one uses slots, each holding
+ * (fingerprint << 32) | (line + 1), with 0 for an empty slot.
+ *
+ * @param   mask            full: number of buckets - 1 (a power of two)
+ * @param   count           compact: number of buckets
+ * @param   buckets         full: bucket array, cache line aligned
+ * @param   slots           compact: slot array, cache line aligned
+ * @param   memory          allocation holding buckets or slots
+ * @param   victim          rotates the slot displaced by an insert
+ * @param   held            tags held
+ * @param   limit           tags held before the index grows
+ * @param   source          compact: gives the tag of a line, else NULL
+ * @param   context         passed to source
+ * @param   needed          compact: buckets for every line at 7/8 full
+ */
+
+struct TagIndex_ {
+    unsigned long mask;
+    unsigned long count;
+    TagBucket* buckets;
+    uint64_t* slots;
+    void* memory;
+    unsigned long victim;
+    unsigned long held;
+    unsigned long limit;
+    TagSource source;
+    const void* context;
+    unsigned long needed;
+};
+
+/* Growing reinserts through the place functions, which grow when stuck */
+static void growTagIndex(TagIndex index);
+static void growCompact(TagIndex index);
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* mixFirst
+ *
+ * Fibonacci hashing. Consecutive tags land far apart, which spreads the
+ * sequential access patterns common in traces.
+ */
+
+static unsigned long mixFirst(unsigned long tag)
+{
+    return tag * 0x9E3779B97F4A7C15UL;
+}
+
+/* mixSecond
+ *
+ * A murmur style finalizer, independent of mixFirst so two tags that
+ * share one bucket rarely share the other.
+ */
+
+static unsigned long mixSecond(unsigned long tag)
+{
+    tag ^= tag >> 33;
+    tag *= 0xFF51AFD7ED558CCDUL;
+    tag ^= tag >> 33;
+
+    return tag;
+}
+
+/* hashFirst
+ *
+ * First bucket of tag in a full index.
+ */
+
+static unsigned long hashFirst(TagIndex index, unsigned long tag)
+{
+    return (mixFirst(tag) >> 20) & index->mask;
+}
+
+/* hashSecond
+ *
+ * Second bucket of tag in a full index.
+ */
+
+static unsigned long hashSecond(TagIndex index, unsigned long tag)
+{
+    return mixSecond(tag) & index->mask;
+}
+
+/* bucketMatches
+ *
+ * Returns a bit per slot of bucket that holds tag. With SSE2 all four
+ * tags are compared at once: 32 bit halves are compared, each half's
+ * result is ANDed with its neighbour's, and one bit per tag is
+ * extracted. Empty slots keep stale tags, so they are masked out.
+ */
+
+static int bucketMatches(const TagBucket* bucket, unsigned long tag)
+{
+#if defined(__SSE2__) && defined(__LP64__)
+    __m128i key, low, high, empty;
+    int matches;
+
+    key = _mm_loadl_epi64((const __m128i*)&tag);
+    key = _mm_unpacklo_epi64(key, key);
+
+    low = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)&bucket->tags[0]), key);
+    high = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)&bucket->tags[2]), key);
+    low = _mm_and_si128(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+    high = _mm_and_si128(high, _mm_shuffle_epi32(high, _MM_SHUFFLE(2, 3, 0, 1)));
+    empty = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)bucket->lines), _mm_set1_epi32(-1));
+
+    matches = _mm_movemask_pd(_mm_castsi128_pd(low)) | (_mm_movemask_pd(_mm_castsi128_pd(high)) << 2);
+
+    return matches & ~_mm_movemask_ps(_mm_castsi128_ps(empty));
+#else
+    int matches, slot;
+
+    matches = 0;
+    for(slot = 0; slot < TAGINDEX_SLOTS; slot++)
+    {
+        matches |= (bucket->tags[slot] == tag && bucket->lines[slot] != -1) << slot;
+    }
+
+    return matches;
+#endif
+}
+
+/* bucketFind
+ *
+ * Returns the slot of bucket holding tag, or -1.
+ */
+
+static int bucketFind(const TagBucket* bucket, unsigned long tag)
+{
+    return slotOf[bucketMatches(bucket, tag)];
+}
+
+/* bucketFree
+ *
+ * Returns an empty slot of bucket, or -1 if it is full.
+ */
+
+static int bucketFree(const TagBucket* bucket)
+{
+    int slot;
+
+    for(slot = 0; slot < TAGINDEX_SLOTS; slot++)
+    {
+        if(bucket->lines[slot] == -1)
+        {
+            return slot;
+        }
+    }
+
+    return -1;
+}
+
+/* allocateBuckets
+ *
+ * Gives a full index count empty, cache line aligned buckets, to be
+ * kept at most half full.
+ */
+
+static void allocateBuckets(TagIndex index, unsigned long count)
+{
+    unsigned long i;
+    int slot;
+
+    index->memory = malloc(sizeof(TagBucket) * count + TAGINDEX_ALIGN);
+    assert(index->memory != NULL);
+
+    index->buckets = (TagBucket*)(((unsigned long)index->memory + TAGINDEX_ALIGN - 1) & ~(unsigned long)(TAGINDEX_ALIGN - 1));
+    index->mask = count - 1;
+    index->limit = count * TAGINDEX_SLOTS / 2;
+
+    for(i = 0; i < count; i++)
+    {
+        for(slot = 0; slot < TAGINDEX_SLOTS; slot++)
+        {
+            index->buckets[i].tags[slot] = 0;
+            index->buckets[i].lines[slot] = -1;
+        }
+    }
+}
+
+/* hashedPlace
+ *
+ * Stores tag in one of its two buckets of a full index, displacing
+ * other tags to their other bucket as needed.
+ */
+
+static void hashedPlace(TagIndex index, unsigned long tag, int line)
+{
+    TagBucket* bucket;
+    unsigned long home, other, swapTag;
+    int slot, swapLine, kick;
+
+    home = hashFirst(index, tag);
+
+    for(kick = 0; kick < TAGINDEX_KICKS; kick++)
+    {
+        other = hashSecond(index, tag);
+
+        /* Whichever of the tag's two buckets has room */
+        slot = bucketFree(&index->buckets[home]);
+        if(slot == -1 && other != home)
+        {
+            slot = bucketFree(&index->buckets[other]);
+            home = (slot == -1) ? home : other;
+        }
+
+        if(slot != -1)
+        {
+            index->buckets[home].tags[slot] = tag;
+            index->buckets[home].lines[slot] = line;
+            return;
+        }
+
+        /* Both full: displace a tag from home, which then goes to its
+           other bucket */
+        bucket = &index->buckets[home];
+        slot = (int)(index->victim++ % TAGINDEX_SLOTS);
+
+        swapTag = bucket->tags[slot];
+        swapLine = bucket->lines[slot];
+        bucket->tags[slot] = tag;
+        bucket->lines[slot] = line;
+        tag = swapTag;
+        line = swapLine;
+
+        other = hashFirst(index, tag);
+        home = (other == home) ? hashSecond(index, tag) : other;
+    }
+
+    /* The displaced tag is still homeless */
+    growTagIndex(index);
+    hashedPlace(index, tag, line);
+}
+
+/* growTagIndex
+ *
+ * Doubles the buckets of a full index and reinserts every tag.
+ */
+
+static void growTagIndex(TagIndex index)
+{
+    TagBucket* old;
+    void* memory;
+    unsigned long count, i;
+    int slot;
+
+    old = index->buckets;
+    memory = index->memory;
+    count = index->mask + 1;
+
+    allocateBuckets(index, count * 2);
+
+    for(i = 0; i < count; i++)
+    {
+        for(slot = 0; slot < TAGINDEX_SLOTS; slot++)
+        {
+            if(old[i].lines[slot] != -1)
+            {
+                hashedPlace(index, old[i].tags[slot], old[i].lines[slot]);
+            }
+        }
+    }
+
+    free(memory);
+}
+
+/********************************
+ *    4. Compact Functions      *
+ ********************************/
+
+/* compactKey
+ *
+ * Fingerprint of tag, the high half of its slots. Never 0, so an empty
+ * slot cannot match.
+ */
+
+static unsigned int compactKey(unsigned long tag)
+{
+    unsigned int key;
+
+    key = (unsigned int)(mixSecond(tag) & 0xFFFFFFFFUL);
+
+    return (key != 0) ? key : 1;
+}
+
+/* compactBucket
+ *
+ * Maps 32 bits of a hash onto the buckets, whose number need not be a
+ * power of two.
+ */
+
+static uint64_t* compactBucket(TagIndex index, unsigned long hash)
+{
+    return index->slots + (((hash >> 32) * index->count) >> 32) * TAGINDEX_COMPACT_SLOTS;
+}
+
+/* compactMatches
+ *
+ * Returns a bit per slot of bucket whose fingerprint equals key. With
+ * SSE2 two slots are compared at once as four 32 bit halves, and the
+ * high half of each gives its slot's bit.
+ */
+
+static int compactMatches(const uint64_t* bucket, unsigned int key)
+{
+    int matches, slot;
+#ifdef __SSE2__
+    __m128i keys;
+    int halves;
+
+    keys = _mm_set1_epi32((int)key);
+
+    matches = 0;
+    for(slot = 0; slot < TAGINDEX_COMPACT_SLOTS; slot += 2)
+    {
+        halves = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_load_si128((const __m128i*)(bucket + slot)), keys)));
+        matches |= (((halves >> 1) & 1) | ((halves >> 2) & 2)) << slot;
+    }
+#else
+    matches = 0;
+    for(slot = 0; slot < TAGINDEX_COMPACT_SLOTS; slot++)
+    {
+        matches |= ((unsigned int)(bucket[slot] >> 32) == key) << slot;
+    }
+#endif
+
+    return matches;
+}
+
+/* compactFree
+ *
+ * Returns an empty slot of a compact bucket, or -1 if it is full.
+ */
+
+static int compactFree(const uint64_t* bucket)
+{
+    int slot;
+
+    for(slot = 0; slot < TAGINDEX_COMPACT_SLOTS; slot++)
+    {
+        if(bucket[slot] == 0)
+        {
+            return slot;
+        }
+    }
+
+    return -1;
+}
+
+/* compactFind
+ *
+ * Returns the slot holding tag in a compact index, or NULL. Every
+ * fingerprint match is confirmed by reading the line's tag back.
+ */
+
+static uint64_t* compactFind(TagIndex index, unsigned long tag)
+{
+    uint64_t *first, *bucket;
+    unsigned int key;
+    int matches, slot;
+
+    key = compactKey(tag);
+
+    first = compactBucket(index, mixFirst(tag));
+    bucket = first;
+
+    for(;;)
+    {
+        matches = compactMatches(bucket, key);
+
+        for(slot = 0; matches != 0; slot++, matches >>= 1)
+        {
+            if((matches & 1) && index->source(index->context, (int)(bucket[slot] & 0xFFFFFFFFUL) - 1) == tag)
+            {
+                return &bucket[slot];
+            }
+        }
+
+        if(bucket != first)
+        {
+            return NULL;
+        }
+
+        bucket = compactBucket(index, mixSecond(tag));
+        if(bucket == first)
+        {
+            return NULL;
+        }
+    }
+}
+
+/* allocateCompact
+ *
+ * Gives a compact index count empty, cache line aligned buckets, to be
+ * kept at most 7/8 full. The memory comes zeroed from calloc, so pages
+ * no tag has landed in are never touched.
+ */
+
+static void allocateCompact(TagIndex index, unsigned long count)
+{
+    index->memory = calloc(count * TAGINDEX_COMPACT_SLOTS * sizeof(uint64_t) + TAGINDEX_ALIGN, 1);
+    assert(index->memory != NULL);
+
+    index->slots = (uint64_t*)(((unsigned long)index->memory + TAGINDEX_ALIGN - 1) & ~(unsigned long)(TAGINDEX_ALIGN - 1));
+    index->count = count;
+    index->limit = count * TAGINDEX_COMPACT_SLOTS / 8 * 7;
+}
+
+/* compactPlace
+ *
+ * Stores the slot value for tag in one of its two buckets of a compact
+ * index, displacing other values to their other bucket as needed. A
+ * displaced value's tag is read back from its line.
+ */
+
+static void compactPlace(TagIndex index, unsigned long tag, uint64_t value)
+{
+    uint64_t *home, *other, *first, swap;
+    int slot, kick;
+
+    home = compactBucket(index, mixFirst(tag));
+
+    for(kick = 0; kick < TAGINDEX_KICKS; kick++)
+    {
+        other = compactBucket(index, mixSecond(tag));
+
+        slot = compactFree(home);
+        if(slot == -1 && other != home)
+        {
+            slot = compactFree(other);
+            home = (slot == -1) ? home : other;
+        }
+
+        if(slot != -1)
+        {
+            home[slot] = value;
+            return;
+        }
+
+        slot = (int)(index->victim++ % TAGINDEX_COMPACT_SLOTS);
+        swap = home[slot];
+        home[slot] = value;
+        value = swap;
+        tag = index->source(index->context, (int)(value & 0xFFFFFFFFUL) - 1);
+
+        first = compactBucket(index, mixFirst(tag));
+        home = (first == home) ? compactBucket(index, mixSecond(tag)) : first;
+    }
+
+    growCompact(index);
+    compactPlace(index, tag, value);
+}
+
+/* growCompact
+ *
+ * Doubles the buckets of a compact index and reinserts every value. The
+ * last step stops at the size every line needs, so a full cache is not
+ * left with an index nearly twice as large as it has to be.
+ */
+
+static void growCompact(TagIndex index)
+{
+    uint64_t* old;
+    void* memory;
+    unsigned long slots, count, i;
+
+    old = index->slots;
+    memory = index->memory;
+    slots = index->count * TAGINDEX_COMPACT_SLOTS;
+
+    count = index->count * 2;
+    if(count > index->needed && index->needed > index->count)
+    {
+        count = index->needed;
+    }
+
+    allocateCompact(index, count);
+
+    for(i = 0; i < slots; i++)
+    {
+        if(old[i] != 0)
+        {
+            compactPlace(index, index->source(index->context, (int)(old[i] & 0xFFFFFFFFUL) - 1), old[i]);
+        }
+    }
+
+    free(memory);
+}
+
+/********************************
+ *    5. TagIndex Functions     *
+ ********************************/
+
+/* createTagIndex
+ * ...
+ */
+
+TagIndex createTagIndex(int entries)
+{
+    TagIndex index;
+    unsigned long count, initial;
+
+    if(entries <= 0)
+    {
+        fprintf(stderr, "Invalid tag index size.\n");
+        return NULL;
+    }
+
+    index = (TagIndex)calloc(1, sizeof(struct TagIndex_));
+    assert(index != NULL);
+
+    /* At most half the slots in use */
+    initial = (entries < TAGINDEX_INITIAL) ? (unsigned long)entries : TAGINDEX_INITIAL;
+    count = 1;
+    while(count * TAGINDEX_SLOTS < 2 * initial)
+    {
+        count = count * 2;
+    }
+
+    allocateBuckets(index, count);
+
+    return index;
+}
+
+/* createCompactTagIndex
+ * ...
+ */
+
+TagIndex createCompactTagIndex(int entries, TagSource source, const void* context)
+{
+    TagIndex index;
+    unsigned long initial;
+
+    if(entries <= 0 || source == NULL)
+    {
+        fprintf(stderr, "Invalid tag index size.\n");
+        return NULL;
+    }
+
+    index = (TagIndex)calloc(1, sizeof(struct TagIndex_));
+    assert(index != NULL);
+
+    index->source = source;
+    index->context = context;
+
+    index->needed = ((unsigned long)entries * 8 + TAGINDEX_COMPACT_SLOTS * 7 - 1) / (TAGINDEX_COMPACT_SLOTS * 7);
+
+    initial = (entries < TAGINDEX_INITIAL) ? (unsigned long)entries : TAGINDEX_INITIAL;
+    allocateCompact(index, (initial * 8 + TAGINDEX_COMPACT_SLOTS * 7 - 1) / (TAGINDEX_COMPACT_SLOTS * 7));
+
+    return index;
+}
+
+/* destroyTagIndex
+ * ...
+ */
+
+void destroyTagIndex(TagIndex index)
+{
+    if(index != NULL)
+    {
+        free(index->memory);
+        free(index);
+    }
+}
+
+/* tagIndexFind
+ * ...
+ */
+
+int tagIndexFind(TagIndex index, unsigned long tag)
+{
+    TagBucket* bucket;
+    uint64_t* slot;
+    int found;
+
+    if(index->source != NULL)
+    {
+        slot = compactFind(index, tag);
+        return (slot != NULL) ? (int)(*slot & 0xFFFFFFFFUL) - 1 : -1;
+    }
+
+    bucket = &index->buckets[hashFirst(index, tag)];
+    found = bucketFind(bucket, tag);
+
+    if(found == -1)
+    {
+        bucket = &index->buckets[hashSecond(index, tag)];
+        found = bucketFind(bucket, tag);
+
+        if(found == -1)
+        {
+            return -1;
+        }
+    }
+
+    return bucket->lines[found];
+}
+
+/* tagIndexInsert
+ * ...
+ */
+
+void tagIndexInsert(TagIndex index, unsigned long tag, int line)
+{
+    if(index->source != NULL)
+    {
+        assert(index->source(index->context, line) == tag);
+
+        if(++index->held > index->limit)
+        {
+            growCompact(index);
+        }
+
+        compactPlace(index, tag, ((uint64_t)compactKey(tag) << 32) | (uint64_t)(line + 1));
+        return;
+    }
+
+    if(++index->held > index->limit)
+    {
+        growTagIndex(index);
+    }
+
+    hashedPlace(index, tag, line);
+}
+
+/* tagIndexRemove
+ * ...
+ */
+
+void tagIndexRemove(TagIndex index, unsigned long tag)
+{
+    TagBucket* bucket;
+    uint64_t* slot;
+    int found;
+
+    if(index->source != NULL)
+    {
+        slot = compactFind(index, tag);
+        if(slot != NULL)
+        {
+            *slot = 0;
+            index->held--;
+        }
+        return;
+    }
+
+    bucket = &index->buckets[hashFirst(index, tag)];
+    found = bucketFind(bucket, tag);
+
+    if(found == -1)
+    {
+        bucket = &index->buckets[hashSecond(index, tag)];
+        found = bucketFind(bucket, tag);
+    }
+
+    if(found != -1)
+    {
+        bucket->lines[found] = -1;
+        index->held--;
+    }
+}
@@ -0,0 +1,133 @@
+/* File: tagindex.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * The tag index maps the tag of every valid block to the cache line
+ * holding it, so a fully associative lookup costs one hash probe instead
+ * of a scan over every line. It is a bucketized cuckoo hash table: each
+ * tag lives in one of two buckets chosen by two independent hashes, and
+ * each bucket is four slots in one 64 byte cache line. A lookup touches
+ * at most those two lines whatever the tags are, so adversarial or
+ * strided traces cannot build up the long probe runs of linear probing.
+ * Slots within a bucket are compared with SSE2 where it is available,
+ * empty slots masked out in the same pass, so a probe does not branch
+ * per slot.
+ *
+ * The table is kept at most half full. An insert that finds both buckets
+ * full displaces a tag to its other bucket, and after a bounded number of
+ * displacements the table doubles, so inserts never fail. Tables start
+ * small and double as tags arrive, so a huge cache that a trace only
+ * partly fills costs only what the trace touches.
+ *
+ * A compact index stores no tags at all. Each slot is 64 bits: the line
+ * plus one in the low half and a 32 bit fingerprint of the tag in the
+ * high half, eight slots to a cache line. A fingerprint match is
+ * confirmed by reading the line's tag back through a TagSource, so the
+ * cache's own tag store is the only copy. A lookup compares at most
+ * sixteen slots, so the chance that one reads back a tag that turns out
+ * not to match is below 16 / 2^32, about 4 in a billion, whatever the
+ * number of lines. It is kept up to 7/8 full and costs about 9.1 bytes
+ * per line against 32 for the full index.
+ */
+
+#ifndef SWIFT_TAGINDEX_H_
+#define SWIFT_TAGINDEX_H_
+
+/* Typedefs */
+typedef struct TagIndex_* TagIndex;
+
+/* TagSource
+ *
+ * Gives the tag currently held in line, for a compact index.
+ *
+ * @param   context         context given to createCompactTagIndex
+ * @param   line            line number
+ *
+ * @return  tag             block tag held in line
+ */
+
+typedef unsigned long (*TagSource)(const void* context, int line);
+
+
+/* createTagIndex
+ *
+ * Function to create an empty index able to hold entries tags.
+ * Returns the new index on success and NULL on failure.
+ *
+ * @param   entries         maximum number of tags held at once
+ *
+ * @return  success         new TagIndex
+ * @return  failure         NULL
+ */
+
+TagIndex createTagIndex(int entries);
+
+/* createCompactTagIndex
+ *
+ * Function to create an empty compact index able to hold entries tags,
+ * one per line from 0 to entries - 1. A tag must be readable through
+ * source from the moment it is inserted until it is removed. Returns the
+ * new index on success and NULL on failure.
+ *
+ * @param   entries         number of lines
+ * @param   source          gives the tag held in a line
+ * @param   context         passed to source
+ *
+ * @return  success         new TagIndex
+ * @return  failure         NULL
+ */
+
+TagIndex createCompactTagIndex(int entries, TagSource source, const void* context);
+
+/* destroyTagIndex
+ *
+ * Frees all memory held by the index. Passing NULL does nothing.
+ *
+ * @param   index           index to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyTagIndex(TagIndex index);
+
+/* tagIndexFind
+ *
+ * Returns the line holding tag, or -1 if the tag is not present.
+ *
+ * @param   index           target index
+ * @param   tag             block tag
+ *
+ * @return  found           line number
+ * @return  not found       -1
+ */
+
+int tagIndexFind(TagIndex index, unsigned long tag);
+
+/* tagIndexInsert
+ *
+ * Records that tag is held in line. The tag must not already be present.
+ *
+ * @param   index           target index
+ * @param   tag             block tag
+ * @param   line            line number
+ *
+ * @return  void
+ */
+
+void tagIndexInsert(TagIndex index, unsigned long tag, int line);
+
+/* tagIndexRemove
+ *
+ * Removes tag from the index. Removing a missing tag does nothing.
+ *
+ * @param   index           target index
+ * @param   tag             block tag
+ *
+ * @return  void
+ */
+
+void tagIndexRemove(TagIndex index, unsigned long tag);
+
+
+#endif
+/* SWIFT_TAGINDEX_H_ */
@@ -0,0 +1,185 @@
+/* File: tlb.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Data TLB hierarchy. See tlb.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -Tlb
+ *      3. Tlb Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "tlb.h"
+#include "sim.h"
+#include "policy.h"
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* Tlb
+ *
+ * @param   pageBits        log2 of the page size
+ * @param   dtlb            L1 DTLB, one byte block per page number
+ * @param   stlb            STLB, or NULL
+ * @param   stats           counters
+ */
+
+struct Tlb_ {
+    int pageBits;
+    Cache dtlb;
+    Cache stlb;
+    TlbStats stats;
+};
+
+/********************************
+ *      3. Tlb Functions        *
+ ********************************/
+
+/* createTlb
+ * ...
+ */
+
+Tlb createTlb(int dtlb_entries, int stlb_entries, long page_size)
+{
+    Tlb tlb;
+
+    if(dtlb_entries <= 0 || stlb_entries < 0 || page_size < 2 || (page_size & (page_size - 1)) != 0)
+    {
+        fprintf(stderr, "Invalid TLB parameters.\n");
+        return NULL;
+    }
+
+    tlb = (Tlb)malloc(sizeof(struct Tlb_));
+    assert(tlb != NULL);
+
+    tlb->pageBits = 0;
+    while((1L << tlb->pageBits) < page_size)
+    {
+        tlb->pageBits++;
+    }
+
+    tlb->dtlb = createCache(dtlb_entries, 1, 0, POLICY_LRU);
+    tlb->stlb = NULL;
+    if(stlb_entries > 0)
+    {
+        tlb->stlb = createCache(stlb_entries, 1, 0, POLICY_LRU);
+    }
+
+    if(tlb->dtlb == NULL || (stlb_entries > 0 && tlb->stlb == NULL))
+    {
+        destroyTlb(tlb);
+        return NULL;
+    }
+
+    memset(&tlb->stats, 0, sizeof(TlbStats));
+
+    return tlb;
+}
+
+/* destroyTlb
+ * ...
+ */
+
+void destroyTlb(Tlb tlb)
+{
+    if(tlb != NULL)
+    {
+        destroyCache(tlb->dtlb);
+        destroyCache(tlb->stlb);
+        free(tlb);
+    }
+}
+
+/* tlbAccess
+ * ...
+ */
+
+int tlbAccess(Tlb tlb, unsigned long address)
+{
+    return tlbAccessRun(tlb, address, 1);
+}
+
+/* tlbAccessRun
+ * ...
+ */
+
+int tlbAccessRun(Tlb tlb, unsigned long address, unsigned long count)
+{
+    unsigned long page;
+
+    page = address >> tlb->pageBits;
+
+    /* Only the first access can miss; the rest find the page the
+       DTLB was just filled with */
+    tlb->stats.dtlbHits += count - 1;
+    if(accessCacheRun(tlb->dtlb, 0, page, 0, count, 0))
+    {
+        tlb->stats.dtlbHits++;
+        return TLB_DTLB_HIT;
+    }
+    tlb->stats.dtlbMisses++;
+
+    if(tlb->stlb != NULL && accessCache(tlb->stlb, page, 0))
+    {
+        tlb->stats.stlbHits++;
+        return TLB_STLB_HIT;
+    }
+
+    tlb->stats.walks++;
+    return TLB_WALK;
+}
+
+/* tlbWalk
+ * ...
+ */
+
+int tlbWalk(Tlb tlb, unsigned long address, unsigned long* entries)
+{
+    int level, shift, count;
+
+    /* Level 0 is the root, covering 512GB per entry; a walk stops at
+       the level whose entries map a whole page */
+    count = 0;
+    for(level = 0; level < TLB_WALK_LEVELS; level++)
+    {
+        shift = 39 - 9 * level;
+        entries[count++] = TLB_WALK_BASE + ((unsigned long)level << 41) +
+                           ((address >> shift) & ((1UL << (48 - shift)) - 1)) * 8;
+
+        if(shift <= tlb->pageBits)
+        {
+            break;
+        }
+    }
+
+    return count;
+}
+
+/* tlbPageBits
+ * ...
+ */
+
+int tlbPageBits(Tlb tlb)
+{
+    return tlb->pageBits;
+}
+
+/* tlbGetStats
+ * ...
+ */
+
+void tlbGetStats(Tlb tlb, TlbStats* stats)
+{
+    *stats = tlb->stats;
+}
@@ -0,0 +1,148 @@
+/* File: tlb.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Data TLB hierarchy: an L1 DTLB backed by an optional second level
+ * STLB, both fully associative LRU. Each level is a cache from sim.h
+ * holding page numbers in one byte blocks, so lookups go through the
+ * same tag index as the data cache.
+ *
+ * Every page is the same size, so comparing runs with 4KB, 2MB and
+ * 1GB pages shows what huge pages would save. A miss in both levels is
+ * a page walk over an x86-64 style radix table with 512 entries per
+ * level: four reads for 4KB pages, three for 2MB and two for 1GB. The
+ * table entries are laid out linearly from TLB_WALK_BASE, so the walk
+ * reads have the locality a real page table has, and tlbWalk returns
+ * them so they can be sent through the data cache.
+ */
+
+#ifndef SWIFT_TLB_H_
+#define SWIFT_TLB_H_
+
+/* Defaults */
+#define TLB_DTLB_ENTRIES 64
+#define TLB_STLB_ENTRIES 1536
+#define TLB_PAGE_SIZE 4096
+
+/* Most reads in one page walk */
+#define TLB_WALK_LEVELS 4
+
+/* Where the page table entries are placed */
+#define TLB_WALK_BASE 0xfff0000000000000UL
+
+/* Levels that translated an access (tlbAccess) */
+#define TLB_DTLB_HIT 0
+#define TLB_STLB_HIT 1
+#define TLB_WALK 2
+
+/* Typedefs */
+typedef struct Tlb_* Tlb;
+
+/* TlbStats
+ *
+ * Counters kept by a Tlb.
+ *
+ * @param   dtlbHits        translations found in the DTLB
+ * @param   dtlbMisses      translations missing from the DTLB
+ * @param   stlbHits        DTLB misses found in the STLB
+ * @param   walks           translations that needed a page walk
+ */
+
+typedef struct TlbStats_ {
+    unsigned long dtlbHits;
+    unsigned long dtlbMisses;
+    unsigned long stlbHits;
+    unsigned long walks;
+} TlbStats;
+
+
+/* createTlb
+ *
+ * Function to create an empty TLB hierarchy. Returns the new TLB on
+ * success and NULL on failure.
+ *
+ * @param   dtlb_entries    DTLB entries
+ * @param   stlb_entries    STLB entries, or 0 for no STLB
+ * @param   page_size       page size in bytes (a power of two)
+ *
+ * @return  success         new Tlb
+ * @return  failure         NULL
+ */
+
+Tlb createTlb(int dtlb_entries, int stlb_entries, long page_size);
+
+/* destroyTlb
+ *
+ * Frees all memory held by the TLB. Passing NULL does nothing.
+ *
+ * @param   tlb             TLB to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyTlb(Tlb tlb);
+
+/* tlbAccess
+ *
+ * Translates address, filling the levels that missed.
+ *
+ * @param   tlb             target TLB
+ * @param   address         virtual byte address
+ *
+ * @return  int             TLB_DTLB_HIT, TLB_STLB_HIT or TLB_WALK
+ */
+
+int tlbAccess(Tlb tlb, unsigned long address);
+
+/* tlbAccessRun
+ *
+ * Translates count accesses in a row to the page holding address, as
+ * count calls to tlbAccess would.
+ *
+ * @param   tlb             target TLB
+ * @param   address         virtual byte address
+ * @param   count           number of accesses
+ *
+ * @return  int             level that translated the first access
+ */
+
+int tlbAccessRun(Tlb tlb, unsigned long address, unsigned long count);
+
+/* tlbWalk
+ *
+ * Gives the page table entries read to translate address, from the
+ * root down.
+ *
+ * @param   tlb             target TLB
+ * @param   address         virtual byte address
+ * @param   entries         filled with up to TLB_WALK_LEVELS addresses
+ *
+ * @return  int             number of entries read
+ */
+
+int tlbWalk(Tlb tlb, unsigned long address, unsigned long* entries);
+
+/* tlbPageBits
+ *
+ * @param   tlb             target TLB
+ *
+ * @return  int             log2 of the page size
+ */
+
+int tlbPageBits(Tlb tlb);
+
+/* tlbGetStats
+ *
+ * Copies out the counters.
+ *
+ * @param   tlb             target TLB
+ * @param   stats           filled with the counters
+ *
+ * @return  void
+ */
+
+void tlbGetStats(Tlb tlb, TlbStats* stats);
+
+
+#endif
+/* SWIFT_TLB_H_ */
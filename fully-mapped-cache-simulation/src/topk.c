@@ -0,0 +1,342 @@
+/* File: topk.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Heavy hitter counting. See topk.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -TopEntry
+ *          -TopK
+ *      3. Utility Functions
+ *          -compareEntries
+ *          -growTopK
+ *          -sortEntries
+ *      4. TopK Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "topk.h"
+#include "freqlist.h"
+#include "tagindex.h"
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* TopEntry
+ *
+ * One counter, copied out for sorting when the report is printed.
+ *
+ * @param   key             key counted
+ * @param   count           count, an overestimate by at most error
+ * @param   error           count inherited from the key replaced
+ */
+
+typedef struct {
+    unsigned long key;
+    unsigned long count;
+    unsigned long error;
+} TopEntry;
+
+/* TopK
+ *
+ * Counters are numbered 0 to used - 1. A sketch keeps their counts in
+ * freq; exact mode never replaces a key, so a plain array is enough.
+ *
+ * @param   exact           1 = exact counts, 0 = Space-Saving
+ * @param   counters        number of counters allocated
+ * @param   used            number of counters holding a key
+ * @param   keys            key held by each counter
+ * @param   errors          error of each counter (sketch only)
+ * @param   counts          count of each counter (exact only)
+ * @param   freq            count of each counter (sketch only)
+ * @param   index           maps keys to their counters
+ * @param   total           sum of all occurrences counted
+ */
+
+struct TopK_ {
+    int exact;
+    int counters;
+    int used;
+    unsigned long* keys;
+    unsigned long* errors;
+    unsigned long* counts;
+    FreqList freq;
+    TagIndex index;
+    unsigned long total;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* compareEntries
+ *
+ * qsort order: largest count first, then smallest error (the larger
+ * guaranteed count), then lowest key.
+ */
+
+static int compareEntries(const void* a, const void* b)
+{
+    const TopEntry* x = (const TopEntry*)a;
+    const TopEntry* y = (const TopEntry*)b;
+
+    if(x->count != y->count)
+    {
+        return (x->count > y->count) ? -1 : 1;
+    }
+
+    if(x->error != y->error)
+    {
+        return (x->error < y->error) ? -1 : 1;
+    }
+
+    return (x->key < y->key) ? -1 : (x->key > y->key);
+}
+
+/* growTopK
+ *
+ * Doubles the counters of an exact counter, rebuilding the index.
+ */
+
+static void growTopK(TopK topk)
+{
+    int i;
+
+    topk->counters *= 2;
+    topk->keys = (unsigned long*)realloc(topk->keys, sizeof(unsigned long) * topk->counters);
+    topk->counts = (unsigned long*)realloc(topk->counts, sizeof(unsigned long) * topk->counters);
+    assert(topk->keys != NULL && topk->counts != NULL);
+
+    destroyTagIndex(topk->index);
+    topk->index = createTagIndex(topk->counters);
+    assert(topk->index != NULL);
+
+    for(i = 0; i < topk->used; i++)
+    {
+        tagIndexInsert(topk->index, topk->keys[i], i);
+    }
+}
+
+/* sortEntries
+ *
+ * Returns a copy of the counters, largest first. The caller frees it.
+ */
+
+static TopEntry* sortEntries(TopK topk)
+{
+    TopEntry* entries;
+    int i;
+
+    entries = (TopEntry*)malloc(sizeof(TopEntry) * (topk->used + 1));
+    assert(entries != NULL);
+
+    for(i = 0; i < topk->used; i++)
+    {
+        entries[i].key = topk->keys[i];
+        if(topk->exact)
+        {
+            entries[i].count = topk->counts[i];
+            entries[i].error = 0;
+        }
+        else
+        {
+            entries[i].count = freqListCount(topk->freq, i);
+            entries[i].error = topk->errors[i];
+        }
+    }
+
+    qsort(entries, (size_t)topk->used, sizeof(TopEntry), compareEntries);
+
+    return entries;
+}
+
+/********************************
+ *      4. TopK Functions       *
+ ********************************/
+
+/* createTopK
+ * ...
+ */
+
+TopK createTopK(int counters, int exact)
+{
+    TopK topk;
+
+    if(counters <= 0 || counters > (1 << 28))
+    {
+        fprintf(stderr, "Invalid number of top-k counters.\n");
+        return NULL;
+    }
+
+    topk = (TopK)malloc(sizeof(struct TopK_));
+    assert(topk != NULL);
+
+    topk->exact = exact;
+    topk->counters = counters;
+    topk->used = 0;
+    topk->total = 0;
+    topk->errors = NULL;
+    topk->counts = NULL;
+    topk->freq = NULL;
+
+    topk->keys = (unsigned long*)malloc(sizeof(unsigned long) * counters);
+    assert(topk->keys != NULL);
+
+    if(exact)
+    {
+        topk->counts = (unsigned long*)malloc(sizeof(unsigned long) * counters);
+        assert(topk->counts != NULL);
+    }
+    else
+    {
+        topk->errors = (unsigned long*)malloc(sizeof(unsigned long) * counters);
+        assert(topk->errors != NULL);
+        topk->freq = createFreqList(counters);
+    }
+
+    topk->index = createTagIndex(counters);
+
+    if(topk->index == NULL || (!exact && topk->freq == NULL))
+    {
+        destroyTopK(topk);
+        return NULL;
+    }
+
+    return topk;
+}
+
+/* destroyTopK
+ * ...
+ */
+
+void destroyTopK(TopK topk)
+{
+    if(topk != NULL)
+    {
+        destroyFreqList(topk->freq);
+        destroyTagIndex(topk->index);
+        free(topk->keys);
+        free(topk->errors);
+        free(topk->counts);
+        free(topk);
+    }
+}
+
+/* topKAdd
+ * ...
+ */
+
+void topKAdd(TopK topk, unsigned long key, unsigned long n)
+{
+    int counter;
+
+    topk->total += n;
+    counter = tagIndexFind(topk->index, key);
+
+    if(counter != -1)
+    {
+        if(topk->exact)
+        {
+            topk->counts[counter] += n;
+        }
+        else
+        {
+            freqListAdd(topk->freq, counter, n);
+        }
+        return;
+    }
+
+    if(topk->exact)
+    {
+        if(topk->used == topk->counters)
+        {
+            growTopK(topk);
+        }
+
+        counter = topk->used++;
+        topk->keys[counter] = key;
+        topk->counts[counter] = n;
+        tagIndexInsert(topk->index, key, counter);
+        return;
+    }
+
+    if(topk->used < topk->counters)
+    {
+        counter = topk->used++;
+        topk->keys[counter] = key;
+        topk->errors[counter] = 0;
+        freqListInsert(topk->freq, counter, n);
+        tagIndexInsert(topk->index, key, counter);
+        return;
+    }
+
+    /* Full: the key takes over the smallest counter, whose count
+       becomes its error */
+    counter = freqListMin(topk->freq);
+    tagIndexRemove(topk->index, topk->keys[counter]);
+
+    topk->keys[counter] = key;
+    topk->errors[counter] = freqListCount(topk->freq, counter);
+    freqListAdd(topk->freq, counter, n);
+    tagIndexInsert(topk->index, key, counter);
+}
+
+/* printTopK
+ * ...
+ */
+
+void printTopK(TopK topk, const char* title, int k)
+{
+    TopEntry* entries;
+    int i;
+
+    entries = sortEntries(topk);
+
+    printf("%s:\n", title);
+    for(i = 0; i < k && i < topk->used; i++)
+    {
+        printf("\t0x%08lx: COUNT %lu", entries[i].key, entries[i].count);
+        if(!topk->exact)
+        {
+            printf(" ERROR %lu", entries[i].error);
+        }
+        printf(" SHARE %.3f\n", topk->total ? (double)entries[i].count / (double)topk->total : 0.0);
+    }
+
+    free(entries);
+}
+
+/* reportTopK
+ * ...
+ */
+
+void reportTopK(TopK topk, Report report, const char* name, int k)
+{
+    TopEntry* entries;
+    int i;
+
+    entries = sortEntries(topk);
+
+    reportBeginList(report, name);
+    for(i = 0; i < k && i < topk->used; i++)
+    {
+        reportBegin(report, NULL);
+        reportAddress(report, "address", entries[i].key);
+        reportInt(report, "count", entries[i].count);
+        reportInt(report, "error", entries[i].error);
+        reportReal(report, "share", topk->total ? (double)entries[i].count / (double)topk->total : 0.0);
+        reportEnd(report);
+    }
+    reportEnd(report);
+
+    free(entries);
+}
@@ -0,0 +1,106 @@
+/* File: topk.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Heavy hitter counting. A top-k counter finds the keys (block
+ * addresses here) that occur most often in a stream, without a counter
+ * for every distinct key.
+ *
+ * By default it is a Space-Saving sketch of a fixed number of counters.
+ * A key that is not monitored takes over the counter with the smallest
+ * count, inheriting that count as its error. A counter's count is never
+ * below the key's true count and never more than error above it, and
+ * any key occurring more than total / counters times is always
+ * monitored. The smallest counter comes from a frequency list
+ * (freqlist.h) and counters are found through a tag index (tagindex.h),
+ * so each update is constant time.
+ *
+ * In exact mode the counters grow instead, so every key is counted
+ * exactly at the cost of memory proportional to the number of distinct
+ * keys.
+ */
+
+#ifndef SWIFT_TOPK_H_
+#define SWIFT_TOPK_H_
+
+#include "report.h"
+
+/* Defaults: counters, and keys reported */
+#define TOPK_COUNTERS 4096
+#define TOPK_REPORT 10
+
+/* Typedefs */
+typedef struct TopK_* TopK;
+
+
+/* createTopK
+ *
+ * Function to create a counter with no keys. Returns the new counter on
+ * success and NULL on failure.
+ *
+ * @param   counters        number of counters (the starting number in
+ *                          exact mode)
+ * @param   exact           1 = count every key exactly, 0 = Space-Saving
+ *
+ * @return  success         new TopK
+ * @return  failure         NULL
+ */
+
+TopK createTopK(int counters, int exact);
+
+/* destroyTopK
+ *
+ * Frees all memory held by the counter. Passing NULL does nothing.
+ *
+ * @param   topk            counter to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyTopK(TopK topk);
+
+/* topKAdd
+ *
+ * Counts n occurrences of key.
+ *
+ * @param   topk            target counter
+ * @param   key             key to count
+ * @param   n               number of occurrences
+ *
+ * @return  void
+ */
+
+void topKAdd(TopK topk, unsigned long key, unsigned long n);
+
+/* printTopK
+ *
+ * Prints the k keys with the largest counts as addresses, with each
+ * count, its share of the total and, for a sketch, its error bound.
+ *
+ * @param   topk            target counter
+ * @param   title           heading, e.g. "HOT MISSES"
+ * @param   k               number of keys to print
+ *
+ * @return  void
+ */
+
+void printTopK(TopK topk, const char* title, int k);
+
+/* reportTopK
+ *
+ * Records the k keys with the largest counts as a list of addresses,
+ * counts, shares and error bounds (0 in exact mode).
+ *
+ * @param   topk            target counter
+ * @param   report          target report
+ * @param   name            list name, e.g. "hot_misses"
+ * @param   k               number of keys to record
+ *
+ * @return  void
+ */
+
+void reportTopK(TopK topk, Report report, const char* name, int k);
+
+
+#endif
+/* SWIFT_TOPK_H_ */
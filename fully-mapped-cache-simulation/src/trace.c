@@ -0,0 +1,886 @@
+/* File: trace.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Trace reader. See trace.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -TraceReader
+ *      3. Utility Functions
+ *          -hexValue
+ *          -parseHex
+ *          -fetch
+ *          -copyPart
+ *          -nextLine
+ *          -nextRecord
+ *          -findText
+ *          -detectDialect
+ *          -parseNative
+ *          -parseLackey
+ *          -parsePerf
+ *          -readRecord
+ *      4. TraceReader Functions
+ *          -openTrace
+ *          -closeTrace
+ *          -readTrace
+ *          -readTraceRun
+ *          -traceIncludeFetches
+ *          -traceSplitBlocks
+ *          -traceFormat
+ *          -tellTrace
+ *          -tracePieces
+ *          -seekTrace
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "sim.h"
+#include "trace.h"
+#include "profile.h"
+#include "asyncreader.h"
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* TraceReader
+ *
+ * Accesses are parsed straight out of the buffers of an AsyncReader.
+ * Only a line or record that is split between two buffers is copied.
+ *
+ * @param   input           asynchronous reader on the trace file
+ * @param   format          TRACE_TEXT or TRACE_BINARY
+ * @param   data            current buffer ('\0' terminated)
+ * @param   length          bytes in data
+ * @param   position        bytes of data already parsed
+ * @param   base            file offset of data[0]
+ * @param   buffer          a line split between two buffers
+ * @param   detected        1 once the text dialect is known
+ * @param   fetches         1 = return instruction fetches
+ * @param   splitBits       split accesses at 2^splitBits byte blocks
+ *                          (-1 = never)
+ * @param   lastFetch       address of the last Lackey fetch
+ * @param   record          access being returned piece by piece
+ * @param   pieceAddress    start of the next piece of record
+ * @param   pieceEnd        end of record's bytes
+ * @param   modify          a store half of a modify is still to come
+ * @param   pieces          accesses of record returned so far
+ * @param   recordOffset    byte offset of record
+ * @param   next            readTraceRun: access read ahead
+ * @param   hasNext         readTraceRun: 1 if next holds an access
+ * @param   failed          readTraceRun: a bad line follows the last run
+ */
+
+struct TraceReader_ {
+    AsyncReader input;
+    int format;
+    const char* data;
+    long length;
+    long position;
+    long base;
+    char buffer[LINELENGTH];
+    int detected;
+    int fetches;
+    int splitBits;
+    unsigned long lastFetch;
+    Access record;
+    unsigned long pieceAddress;
+    unsigned long pieceEnd;
+    int modify;
+    int pieces;
+    long recordOffset;
+    Access next;
+    int hasNext;
+    int failed;
+};
+
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* hexValue
+ *
+ * Returns the value of a hex digit, or -1 if c is not one.
+ */
+
+static int hexValue(char c)
+{
+    if(c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    else if(c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    else if(c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+/* parseHex
+ * ...
+ */
+
+unsigned long parseHex(const char* str, const char** end)
+{
+    unsigned long result;
+    int digit;
+
+    result = 0;
+
+    if(str[0] == '0' && (str[1] == 'x' || str[1] == 'X'))
+    {
+        str = str + 2;
+    }
+
+    while((digit = hexValue(*str)) != -1)
+    {
+        result = result * 16 + (unsigned long)digit;
+        str++;
+    }
+
+    if(end != NULL)
+    {
+        *end = str;
+    }
+
+    return result;
+}
+
+/* fetch
+ *
+ * Moves on to the next buffer. Returns 0 at the end of the file.
+ */
+
+static int fetch(TraceReader reader)
+{
+    reader->base += reader->length;
+    reader->length = 0;
+    reader->position = 0;
+
+    reader->data = asyncReaderNext(reader->input, &reader->length, &reader->base);
+
+    return (reader->data != NULL);
+}
+
+/* copyPart
+ *
+ * Appends up to n bytes to the split line in buffer, dropping whatever
+ * does not fit, and returns the new length.
+ */
+
+static int copyPart(TraceReader reader, int used, const char* part, long n)
+{
+    if(n > LINELENGTH - 1 - used)
+    {
+        n = LINELENGTH - 1 - used;
+    }
+
+    memcpy(reader->buffer + used, part, (size_t)n);
+
+    return used + (int)n;
+}
+
+/* nextLine
+ *
+ * Points line at the next line of a text trace and sets stop to the
+ * '\n' or '\0' it stops at. Returns 0 at the end of the file.
+ */
+
+static int nextLine(TraceReader reader, const char** line, const char** stop)
+{
+    const char* start;
+    const char* end;
+    int used;
+
+    if(reader->position >= reader->length && !fetch(reader))
+    {
+        return 0;
+    }
+
+    start = reader->data + reader->position;
+    end = (const char*)memchr(start, '\n', (size_t)(reader->length - reader->position));
+
+    if(end != NULL)
+    {
+        reader->position = (long)(end - reader->data) + 1;
+        *line = start;
+        *stop = end;
+        return 1;
+    }
+
+    /* The line carries on into the next buffer */
+    used = copyPart(reader, 0, start, reader->length - reader->position);
+    reader->position = reader->length;
+
+    while(fetch(reader))
+    {
+        end = (const char*)memchr(reader->data, '\n', (size_t)reader->length);
+
+        if(end != NULL)
+        {
+            used = copyPart(reader, used, reader->data, (long)(end - reader->data));
+            reader->position = (long)(end - reader->data) + 1;
+            break;
+        }
+
+        used = copyPart(reader, used, reader->data, reader->length);
+        reader->position = reader->length;
+    }
+
+    reader->buffer[used] = '\0';
+    *line = reader->buffer;
+    *stop = reader->buffer + used;
+
+    return 1;
+}
+
+/* nextRecord
+ *
+ * Copies the next record of a binary trace. Returns 0 at the end of the
+ * file, including when only part of a record is left.
+ */
+
+static int nextRecord(TraceReader reader, BinaryRecord* record)
+{
+    char* out;
+    long want, n;
+
+    out = (char*)record;
+    want = (long)sizeof(BinaryRecord);
+
+    while(want > 0)
+    {
+        if(reader->position >= reader->length && !fetch(reader))
+        {
+            return 0;
+        }
+
+        n = reader->length - reader->position;
+        if(n > want)
+        {
+            n = want;
+        }
+
+        memcpy(out, reader->data + reader->position, (size_t)n);
+        out += n;
+        want -= n;
+        reader->position += n;
+    }
+
+    return 1;
+}
+
+/* findText
+ *
+ * Returns the first occurrence of text in [p, end), or NULL.
+ */
+
+static const char* findText(const char* p, const char* end, const char* text)
+{
+    size_t n;
+
+    n = strlen(text);
+
+    while(p + n <= end)
+    {
+        if(*p == text[0] && memcmp(p, text, n) == 0)
+        {
+            return p;
+        }
+        p++;
+    }
+
+    return NULL;
+}
+
+/* detectDialect
+ *
+ * Works out which text format a trace is in from its first line.
+ */
+
+static int detectDialect(const char* p, const char* end)
+{
+    if((p[0] == 'I' && p[1] == ' ') ||
+       (p[0] == ' ' && (p[1] == 'L' || p[1] == 'S' || p[1] == 'M') && p[2] == ' '))
+    {
+        return TRACE_LACKEY;
+    }
+
+    if(findText(p, end, "|OP ") != NULL || findText(p, end, "mem-") != NULL ||
+       findText(p, end, "mem_") != NULL || findText(p, end, "ldlat") != NULL)
+    {
+        return TRACE_PERF;
+    }
+
+    return TRACE_TEXT;
+}
+
+/* parseNative
+ *
+ * Parses a <pc>: <op> <address> [<size>] line.
+ */
+
+static int parseNative(const char* p, Access* access)
+{
+    access->pc = parseHex(p, &p);
+
+    while(*p == ':' || *p == ' ' || *p == '\t')
+    {
+        p++;
+    }
+
+    if(*p == 'R')
+    {
+        access->write = 0;
+    }
+    else if(*p == 'W')
+    {
+        access->write = 1;
+    }
+    else
+    {
+        return -1;
+    }
+
+    p++;
+    while(*p == ' ' || *p == '\t')
+    {
+        p++;
+    }
+
+    access->address = parseHex(p, &p);
+    access->size = 0;
+    access->fetch = 0;
+
+    while(*p == ' ' || *p == '\t')
+    {
+        p++;
+    }
+
+    while(*p >= '0' && *p <= '9')
+    {
+        access->size = access->size * 10 + (unsigned long)(*p - '0');
+        p++;
+    }
+
+    return 1;
+}
+
+/* parseLackey
+ *
+ * Parses a Lackey line. Sets modify for an M line.
+ */
+
+static int parseLackey(TraceReader reader, const char* p, Access* access, int* modify)
+{
+    char kind;
+
+    while(*p == ' ')
+    {
+        p++;
+    }
+
+    kind = *p++;
+
+    while(*p == ' ')
+    {
+        p++;
+    }
+
+    access->address = parseHex(p, &p);
+    access->size = 0;
+
+    if(*p == ',')
+    {
+        p++;
+        while(*p >= '0' && *p <= '9')
+        {
+            access->size = access->size * 10 + (unsigned long)(*p - '0');
+            p++;
+        }
+    }
+
+    access->fetch = 0;
+    access->write = 0;
+    access->pc = reader->lastFetch;
+    *modify = 0;
+
+    switch(kind)
+    {
+        case 'I':
+            access->fetch = 1;
+            access->pc = access->address;
+            reader->lastFetch = access->address;
+            break;
+
+        case 'L':
+            break;
+
+        case 'S':
+            access->write = 1;
+            break;
+
+        case 'M':
+            *modify = 1;
+            break;
+
+        default:
+            return -1;
+    }
+
+    return 1;
+}
+
+/* parsePerf
+ *
+ * Parses a perf mem script line. Returns 0 for lines of other events.
+ */
+
+static int parsePerf(const char* p, const char* end, Access* access)
+{
+    const char* event;
+    const char* field;
+    const char* q;
+
+    /* The event name is the first field ending in ':' that names a
+       memory event */
+    event = NULL;
+    field = p;
+
+    while(field < end && event == NULL)
+    {
+        while(field < end && (*field == ' ' || *field == '\t'))
+        {
+            field++;
+        }
+
+        q = field;
+        while(q < end && *q != ' ' && *q != '\t')
+        {
+            q++;
+        }
+
+        if(q > field && q[-1] == ':' &&
+           (findText(field, q, "mem") != NULL || findText(field, q, "ldlat") != NULL))
+        {
+            event = field;
+        }
+
+        field = q;
+    }
+
+    if(event == NULL)
+    {
+        return 0;
+    }
+
+    while(field < end && (*field == ' ' || *field == '\t'))
+    {
+        field++;
+    }
+
+    access->address = parseHex(field, &q);
+    if(q == field)
+    {
+        return -1;
+    }
+
+    access->write = (findText(event, field, "store") != NULL ||
+                     findText(q, end, "|OP STORE") != NULL);
+    access->size = 0;
+    access->fetch = 0;
+    access->pc = 0;
+
+    /* The pc is the first long hex field after the data source */
+    for(p = q; p < end; p++)
+    {
+        if(*p == '|')
+        {
+            q = p + 1;
+        }
+    }
+
+    while(q < end)
+    {
+        while(q < end && (*q == ' ' || *q == '\t'))
+        {
+            q++;
+        }
+
+        field = q;
+        access->pc = parseHex(field, &q);
+
+        if(q - field >= 6 && (q == end || *q == ' ' || *q == '\t'))
+        {
+            break;
+        }
+
+        access->pc = 0;
+        while(q < end && *q != ' ' && *q != '\t')
+        {
+            q++;
+        }
+    }
+
+    return 1;
+}
+
+/* readRecord
+ *
+ * Reads the next record of the trace, whatever its format. Sets modify
+ * for a Lackey modify.
+ */
+
+static int readRecord(TraceReader reader, Access* access, int* modify)
+{
+    const char* p;
+    const char* end;
+    BinaryRecord record;
+    int status;
+
+    *modify = 0;
+
+    if(reader->format == TRACE_BINARY)
+    {
+        if(!nextRecord(reader, &record))
+        {
+            return asyncReaderFailed(reader->input) ? -1 : 0;
+        }
+
+        access->pc = (unsigned long)record.pc;
+        access->address = (unsigned long)record.address;
+        access->write = (record.op == TRACE_WRITE);
+        access->size = (unsigned long)record.size;
+        access->fetch = (record.op == TRACE_FETCH);
+
+        return 1;
+    }
+
+    while(nextLine(reader, &p, &end))
+    {
+        if(*p == '#' || *p == '=' || *p == '\n' || *p == '\r' || *p == '\0')
+        {
+            continue;
+        }
+
+        if(!reader->detected)
+        {
+            reader->format = detectDialect(p, end);
+            reader->detected = 1;
+        }
+
+        switch(reader->format)
+        {
+            case TRACE_LACKEY:
+                status = parseLackey(reader, p, access, modify);
+                break;
+
+            case TRACE_PERF:
+                status = parsePerf(p, end, access);
+                break;
+
+            default:
+                status = parseNative(p, access);
+                break;
+        }
+
+        if(status != 0)
+        {
+            return status;
+        }
+    }
+
+    return asyncReaderFailed(reader->input) ? -1 : 0;
+}
+
+/********************************
+ *   4. TraceReader Functions   *
+ ********************************/
+
+/* openTrace
+ * ...
+ */
+
+TraceReader openTrace(const char* path)
+{
+    TraceReader reader;
+    AsyncReader input;
+
+    input = openAsyncReader(path);
+    if(input == NULL)
+    {
+        return NULL;
+    }
+
+    reader = (TraceReader)malloc(sizeof(struct TraceReader_));
+    assert(reader != NULL);
+
+    reader->input = input;
+    reader->format = TRACE_TEXT;
+    reader->data = NULL;
+    reader->length = 0;
+    reader->position = 0;
+    reader->base = 0;
+    reader->detected = 0;
+    reader->fetches = 0;
+    reader->splitBits = -1;
+    reader->lastFetch = 0;
+    reader->pieceAddress = 0;
+    reader->pieceEnd = 0;
+    reader->modify = 0;
+    reader->pieces = 0;
+    reader->recordOffset = 0;
+    reader->hasNext = 0;
+    reader->failed = 0;
+
+    if(fetch(reader) && reader->length >= 8 && memcmp(reader->data, TRACE_MAGIC, 8) == 0)
+    {
+        reader->format = TRACE_BINARY;
+        reader->position = 8;
+    }
+
+    return reader;
+}
+
+/* closeTrace
+ * ...
+ */
+
+void closeTrace(TraceReader reader)
+{
+    if(reader != NULL)
+    {
+        closeAsyncReader(reader->input);
+        free(reader);
+    }
+}
+
+/* readTrace
+ * ...
+ */
+
+int readTrace(TraceReader reader, Access* access)
+{
+    unsigned long end;
+    int status;
+
+    for(;;)
+    {
+        /* Next piece of a split access */
+        if(reader->pieceAddress < reader->pieceEnd)
+        {
+            *access = reader->record;
+            access->address = reader->pieceAddress;
+
+            end = reader->pieceEnd;
+            if(reader->splitBits >= 0)
+            {
+                end = ((reader->pieceAddress >> reader->splitBits) + 1) << reader->splitBits;
+                if(end > reader->pieceEnd || end <= reader->pieceAddress)
+                {
+                    end = reader->pieceEnd;
+                }
+            }
+
+            if(access->size > 0)
+            {
+                access->size = end - reader->pieceAddress;
+            }
+
+            reader->pieceAddress = end;
+            reader->pieces++;
+
+            return 1;
+        }
+
+        /* Store half of a modify */
+        if(reader->modify)
+        {
+            reader->modify = 0;
+            reader->record.write = 1;
+            reader->pieceAddress = reader->record.address;
+            reader->pieceEnd = reader->record.address + (reader->record.size ? reader->record.size : 1);
+            continue;
+        }
+
+        reader->recordOffset = reader->base + reader->position;
+        reader->pieces = 0;
+
+        PROFILE_BEGIN(PROFILE_PARSE);
+        status = readRecord(reader, &reader->record, &reader->modify);
+        PROFILE_END(PROFILE_PARSE);
+        if(status != 1)
+        {
+            return status;
+        }
+
+        if(reader->record.fetch && !reader->fetches)
+        {
+            continue;
+        }
+
+        /* Most records are returned whole */
+        if(!reader->modify && (reader->splitBits < 0 || reader->record.size <= 1))
+        {
+            *access = reader->record;
+            return 1;
+        }
+
+        reader->pieceAddress = reader->record.address;
+        reader->pieceEnd = reader->record.address + (reader->record.size ? reader->record.size : 1);
+    }
+}
+
+/* readTraceRun
+ * ...
+ */
+
+int readTraceRun(TraceReader reader, int offset_bits, Run* run)
+{
+    Access access;
+    int status;
+
+    if(reader->failed)
+    {
+        return -1;
+    }
+
+    if(!reader->hasNext)
+    {
+        status = readTrace(reader, &reader->next);
+        if(status != 1)
+        {
+            return status;
+        }
+    }
+
+    run->pc = reader->next.pc;
+    run->address = reader->next.address;
+    run->write = reader->next.write;
+    run->count = 1;
+    run->writes = (unsigned long)reader->next.write;
+    reader->hasNext = 0;
+
+    while((status = readTrace(reader, &access)) == 1)
+    {
+        if((access.address >> offset_bits) != (run->address >> offset_bits))
+        {
+            reader->next = access;
+            reader->hasNext = 1;
+            return 1;
+        }
+
+        run->count++;
+        run->writes += (unsigned long)access.write;
+    }
+
+    /* Hand back the run we have; report the bad line on the next call */
+    reader->failed = (status == -1);
+
+    return 1;
+}
+
+/* traceIncludeFetches
+ * ...
+ */
+
+void traceIncludeFetches(TraceReader reader, int include)
+{
+    reader->fetches = include;
+}
+
+/* traceSplitBlocks
+ * ...
+ */
+
+void traceSplitBlocks(TraceReader reader, int offset_bits)
+{
+    reader->splitBits = offset_bits;
+}
+
+/* traceFormat
+ * ...
+ */
+
+int traceFormat(TraceReader reader)
+{
+    return reader->format;
+}
+
+/* tellTrace
+ * ...
+ */
+
+long tellTrace(TraceReader reader)
+{
+    if(tracePieces(reader) > 0)
+    {
+        return reader->recordOffset;
+    }
+
+    return reader->base + reader->position;
+}
+
+/* tracePieces
+ * ...
+ */
+
+int tracePieces(TraceReader reader)
+{
+    if(reader->pieceAddress < reader->pieceEnd || reader->modify)
+    {
+        return reader->pieces;
+    }
+
+    return 0;
+}
+
+/* seekTrace
+ * ...
+ */
+
+int seekTrace(TraceReader reader, long offset)
+{
+    long start;
+
+    reader->hasNext = 0;
+    reader->failed = 0;
+    reader->pieceAddress = 0;
+    reader->pieceEnd = 0;
+    reader->modify = 0;
+    reader->pieces = 0;
+
+    start = asyncReaderSeek(reader->input, offset);
+    if(start == -1)
+    {
+        return 0;
+    }
+
+    reader->data = NULL;
+    reader->base = start;
+    reader->length = 0;
+    reader->position = 0;
+
+    /* The buffer starts at an aligned offset at or before the one
+       wanted; skip the difference */
+    if(fetch(reader))
+    {
+        reader->position = offset - start;
+    }
+
+    return (reader->position <= reader->length);
+}
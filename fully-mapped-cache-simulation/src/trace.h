@@ -0,0 +1,276 @@
+/* File: trace.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Trace reader. Reads a memory access trace one access at a time.
+ *
+ * Text traces have one access per line of the form
+ *
+ *      <pc>: <op> <address> [<size>]
+ *
+ * where <pc> and <address> are hexadecimal, <op> is R or W and the
+ * optional <size> is the number of bytes accessed, in decimal. Lines
+ * starting with '#' (such as "#eof") and blank lines are skipped.
+ *
+ * Binary traces (written by the --filter option, see tracewriter.h)
+ * start with the 8 bytes "SIMTRC01" followed by fixed size records in
+ * native byte order:
+ *
+ *      uint64          pc
+ *      uint64          address
+ *      uint32          size in bytes (0 = unknown)
+ *      uint32          op (TRACE_READ, TRACE_WRITE or TRACE_FETCH)
+ *
+ * openTrace tells the two apart by the magic bytes.
+ *
+ * Two other text formats are recognised from the first line of a text
+ * trace and read natively:
+ *
+ *  - Valgrind Lackey (valgrind --tool=lackey --trace-mem=yes):
+ *
+ *      I  <address>,<size>         instruction fetch
+ *       L <address>,<size>         load
+ *       S <address>,<size>         store
+ *       M <address>,<size>         modify, returned as a load then a store
+ *
+ *    Data accesses take the address of the last fetch as their pc, and
+ *    "==pid==" banner lines are skipped.
+ *
+ *  - perf mem script: lines for mem-loads / mem-stores style events,
+ *    taking the data address from the field after the event name, the
+ *    op from the event name or the "|OP STORE|" data source, and the pc
+ *    from the first long hex field after the data source.
+ *
+ * Instruction fetches are dropped unless traceIncludeFetches is used.
+ * Accesses with a known size that cross a block boundary can be split
+ * into one access per block with traceSplitBlocks.
+ */
+
+#ifndef SWIFT_TRACE_H_
+#define SWIFT_TRACE_H_
+
+#include <stdint.h>
+
+/* Trace Formats */
+#define TRACE_TEXT 0
+#define TRACE_BINARY 1
+
+/* Text Dialects (detected by readTrace) */
+#define TRACE_LACKEY 2
+#define TRACE_PERF 3
+
+/* Binary Trace Ops */
+#define TRACE_READ 0
+#define TRACE_WRITE 1
+#define TRACE_FETCH 2
+
+#define TRACE_MAGIC "SIMTRC01"
+
+/* Typedefs */
+typedef struct TraceReader_* TraceReader;
+
+/* BinaryRecord
+ *
+ * One record of a binary trace.
+ */
+
+typedef struct BinaryRecord_ {
+    uint64_t pc;
+    uint64_t address;
+    uint32_t size;
+    uint32_t op;
+} BinaryRecord;
+
+/* Access
+ *
+ * One memory access from a trace.
+ *
+ * @param   pc              address of the instruction making the access
+ * @param   address         byte address accessed
+ * @param   write           0 = read, 1 = write
+ * @param   size            bytes accessed (0 = unknown)
+ * @param   fetch           1 = instruction fetch (write is 0)
+ */
+
+typedef struct Access_ {
+    unsigned long pc;
+    unsigned long address;
+    int write;
+    unsigned long size;
+    int fetch;
+} Access;
+
+/* Run
+ *
+ * A run of consecutive accesses to the same block, as returned by
+ * readTraceRun. The first access is kept as is; the rest are only
+ * counted, since they are guaranteed to hit.
+ *
+ * @param   pc              pc of the first access
+ * @param   address         byte address of the first access
+ * @param   write           0 = first access is a read, 1 = a write
+ * @param   count           number of accesses in the run
+ * @param   writes          number of writes in the run (including the
+ *                          first access)
+ */
+
+typedef struct Run_ {
+    unsigned long pc;
+    unsigned long address;
+    int write;
+    unsigned long count;
+    unsigned long writes;
+} Run;
+
+
+/* openTrace
+ *
+ * Opens a trace file for reading. Returns the new reader on success and
+ * NULL on failure.
+ *
+ * @param   path            trace file name
+ *
+ * @return  success         new TraceReader
+ * @return  failure         NULL
+ */
+
+TraceReader openTrace(const char* path);
+
+/* closeTrace
+ *
+ * Closes the file and frees the reader. Passing NULL does nothing.
+ *
+ * @param   reader          reader to be closed
+ *
+ * @return  void
+ */
+
+void closeTrace(TraceReader reader);
+
+/* readTrace
+ *
+ * Reads the next access into access.
+ *
+ * @param   reader          target reader
+ * @param   access          filled in with the next access
+ *
+ * @return  success         1
+ * @return  end of trace    0
+ * @return  bad line        -1
+ */
+
+int readTrace(TraceReader reader, Access* access);
+
+/* readTraceRun
+ *
+ * Reads the next run of consecutive accesses to the same block (block
+ * size 2^offset_bits). Reads one access ahead, so a reader should be
+ * used with either readTrace or readTraceRun, not both.
+ *
+ * @param   reader          target reader
+ * @param   offset_bits     log2 of the block size
+ * @param   run             filled in with the next run
+ *
+ * @return  success         1
+ * @return  end of trace    0
+ * @return  bad line        -1
+ */
+
+int readTraceRun(TraceReader reader, int offset_bits, Run* run);
+
+/* traceIncludeFetches
+ *
+ * Makes readTrace return instruction fetches as well as data accesses.
+ * Fetches are dropped by default.
+ *
+ * @param   reader          target reader
+ * @param   include         1 = return fetches, 0 = drop them
+ *
+ * @return  void
+ */
+
+void traceIncludeFetches(TraceReader reader, int include);
+
+/* traceSplitBlocks
+ *
+ * Makes readTrace split every access with a known size into one access
+ * per block of 2^offset_bits bytes that it touches, each with the size
+ * of its part. An offset_bits of -1 turns splitting off (the default).
+ *
+ * @param   reader          target reader
+ * @param   offset_bits     log2 of the block size, or -1
+ *
+ * @return  void
+ */
+
+void traceSplitBlocks(TraceReader reader, int offset_bits);
+
+/* traceFormat
+ *
+ * Returns the format of the trace. Text dialects are known once the
+ * first access has been read.
+ *
+ * @param   reader          target reader
+ *
+ * @return  int             TRACE_TEXT, TRACE_BINARY, TRACE_LACKEY or
+ *                          TRACE_PERF
+ */
+
+int traceFormat(TraceReader reader);
+
+/* tellTrace
+ *
+ * Returns the byte offset the next readTrace starts reading from, for
+ * use with seekTrace (see traceindex.h). When a record has been only
+ * partly returned (a modify, or a split access) this is the start of
+ * that record and tracePieces says how much of it to skip.
+ *
+ * @param   reader          target reader
+ *
+ * @return  long            byte offset in the trace file
+ */
+
+long tellTrace(TraceReader reader);
+
+/* tracePieces
+ *
+ * Returns how many accesses of the record at tellTrace have already
+ * been returned: 0 unless a record has been only partly returned.
+ *
+ * @param   reader          target reader
+ *
+ * @return  int             accesses to skip after seeking to tellTrace
+ */
+
+int tracePieces(TraceReader reader);
+
+/* seekTrace
+ *
+ * Moves the reader to a byte offset returned by tellTrace. Any access
+ * read ahead by readTraceRun is dropped.
+ *
+ * @param   reader          target reader
+ * @param   offset          byte offset in the trace file
+ *
+ * @return  success         1
+ * @return  failure         0
+ */
+
+int seekTrace(TraceReader reader, long offset);
+
+/* parseHex
+ *
+ * Parses a hexadecimal number with an optional 0x prefix, stopping at
+ * the first character that is not a hex digit.
+ *
+ * @param   str             string to parse
+ * @param   end             set to the first character not parsed
+ *
+ * @return  unsigned long   parsed value
+ */
+
+unsigned long parseHex(const char* str, const char** end);
+
+
+#endif
+/* SWIFT_TRACE_H_ */
@@ -0,0 +1,355 @@
+/* File: traceindex.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Trace index. See traceindex.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -TraceIndex
+ *      3. Utility Functions
+ *          -traceStamp
+ *      4. Index Functions
+ *          -indexTrace
+ *      5. TraceIndex Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "traceindex.h"
+
+#define INDEX_MAGIC "SIMIDX03"
+
+/* Header words: every, accesses, chunks and the trace's stamp */
+#define INDEX_HEADER 6
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* TraceIndex
+ *
+ * @param   every           accesses per chunk
+ * @param   length          number of accesses
+ * @param   numChunks       number of chunks
+ * @param   chunks          chunk entries
+ */
+
+struct TraceIndex_ {
+    unsigned long every;
+    unsigned long length;
+    unsigned long numChunks;
+    IndexChunk* chunks;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* traceStamp
+ *
+ * Fills stamp with the size of a file in bytes and its modification
+ * time in seconds and nanoseconds, so an index notices a trace that was
+ * rewritten at the same size. All three are -1 if the file cannot be
+ * found (standard input, for one).
+ */
+
+static void traceStamp(const char* path, uint64_t stamp[3])
+{
+    struct stat info;
+
+    if(strcmp(path, "-") == 0 || stat(path, &info) != 0)
+    {
+        stamp[0] = (uint64_t)-1;
+        stamp[1] = (uint64_t)-1;
+        stamp[2] = (uint64_t)-1;
+        return;
+    }
+
+    stamp[0] = (uint64_t)info.st_size;
+    stamp[1] = (uint64_t)info.st_mtim.tv_sec;
+    stamp[2] = (uint64_t)info.st_mtim.tv_nsec;
+}
+
+/********************************
+ *      4. Index Functions      *
+ ********************************/
+
+/* indexTrace
+ * ...
+ */
+
+int indexTrace(const char* in, const char* out, unsigned long every)
+{
+    TraceReader reader;
+    FILE* file;
+    Access access;
+    IndexChunk chunk;
+    struct stat info;
+    uint64_t header[INDEX_HEADER];
+    unsigned long length, chunks;
+    long offset;
+    int pieces, status, written;
+
+    if(every == 0)
+    {
+        fprintf(stderr, "Invalid chunk size.\n");
+        return 0;
+    }
+
+    reader = openTrace(in);
+    if(reader == NULL)
+    {
+        fprintf(stderr, "Error: Could not open file.\n");
+        return 0;
+    }
+
+    file = fopen(out, "wb");
+    if(file == NULL)
+    {
+        fprintf(stderr, "Error: Could not open output file.\n");
+        closeTrace(reader);
+        return 0;
+    }
+
+    /* Header is rewritten with the real counts at the end */
+    memset(header, 0, sizeof(header));
+    header[0] = (uint64_t)every;
+    written = fwrite(INDEX_MAGIC, 1, 8, file) == 8 &&
+              fwrite(header, sizeof(uint64_t), INDEX_HEADER, file) == INDEX_HEADER;
+
+    length = 0;
+    chunks = 0;
+    status = 0;
+    memset(&chunk, 0, sizeof(chunk));
+
+    offset = tellTrace(reader);
+    pieces = tracePieces(reader);
+    while(written && (status = readTrace(reader, &access)) == 1)
+    {
+        if(length % every == 0)
+        {
+            if(length > 0 && fwrite(&chunk, sizeof(IndexChunk), 1, file) != 1)
+            {
+                written = 0;
+                break;
+            }
+
+            chunk.offset = (uint64_t)offset;
+            chunk.skip = (uint64_t)pieces;
+            chunk.writes = 0;
+            chunk.low = (uint64_t)access.address;
+            chunk.high = (uint64_t)access.address;
+            chunks++;
+        }
+
+        chunk.writes += (uint64_t)access.write;
+        if((uint64_t)access.address < chunk.low)
+        {
+            chunk.low = (uint64_t)access.address;
+        }
+        if((uint64_t)access.address > chunk.high)
+        {
+            chunk.high = (uint64_t)access.address;
+        }
+
+        length++;
+        offset = tellTrace(reader);
+        pieces = tracePieces(reader);
+    }
+
+    if(written && status == 0)
+    {
+        header[1] = (uint64_t)length;
+        header[2] = (uint64_t)chunks;
+        traceStamp(in, header + 3);
+        written = (length == 0 || fwrite(&chunk, sizeof(IndexChunk), 1, file) == 1) &&
+                  fseek(file, 8, SEEK_SET) == 0 &&
+                  fwrite(header, sizeof(uint64_t), INDEX_HEADER, file) == INDEX_HEADER;
+    }
+
+    if(fclose(file) != 0)
+    {
+        written = 0;
+    }
+    closeTrace(reader);
+
+    if(status == -1)
+    {
+        fprintf(stderr, "%lu: ERROR!!!!\n", length);
+    }
+    else if(!written)
+    {
+        fprintf(stderr, "Error: Could not write the trace index.\n");
+    }
+    else
+    {
+        printf("ACCESSES: %lu\nCHUNKS: %lu\nACCESSES PER CHUNK: %lu\n", length, chunks, every);
+    }
+
+    /* A half written index must not be picked up by --start later */
+    if((status != 0 || !written) && stat(out, &info) == 0 && S_ISREG(info.st_mode))
+    {
+        remove(out);
+    }
+
+    return (status == 0 && written);
+}
+
+/********************************
+ *   5. TraceIndex Functions    *
+ ********************************/
+
+/* loadTraceIndex
+ * ...
+ */
+
+TraceIndex loadTraceIndex(const char* path, const char* trace)
+{
+    TraceIndex index;
+    FILE* file;
+    char magic[8];
+    uint64_t header[INDEX_HEADER];
+    uint64_t stamp[3];
+
+    file = fopen(path, "rb");
+    if(file == NULL)
+    {
+        return NULL;
+    }
+
+    if(fread(magic, 1, 8, file) != 8 || memcmp(magic, INDEX_MAGIC, 8) != 0 ||
+       fread(header, sizeof(uint64_t), INDEX_HEADER, file) != INDEX_HEADER || header[0] == 0)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    traceStamp(trace, stamp);
+    if(memcmp(header + 3, stamp, sizeof(stamp)) != 0)
+    {
+        fprintf(stderr, "Warning: %s is out of date, ignoring it.\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    index = (TraceIndex)malloc(sizeof(struct TraceIndex_));
+    assert(index != NULL);
+
+    index->every = (unsigned long)header[0];
+    index->length = (unsigned long)header[1];
+    index->numChunks = (unsigned long)header[2];
+    index->chunks = (IndexChunk*)malloc(sizeof(IndexChunk) * (index->numChunks + 1));
+    assert(index->chunks != NULL);
+
+    if(fread(index->chunks, sizeof(IndexChunk), index->numChunks, file) != index->numChunks)
+    {
+        fprintf(stderr, "Error: Truncated trace index.\n");
+        fclose(file);
+        destroyTraceIndex(index);
+        return NULL;
+    }
+
+    fclose(file);
+
+    return index;
+}
+
+/* destroyTraceIndex
+ * ...
+ */
+
+void destroyTraceIndex(TraceIndex index)
+{
+    if(index != NULL)
+    {
+        free(index->chunks);
+        free(index);
+    }
+}
+
+/* seekTraceIndex
+ * ...
+ */
+
+int seekTraceIndex(TraceReader reader, TraceIndex index, unsigned long k)
+{
+    Access access;
+    unsigned long skip;
+    int status;
+
+    skip = k;
+
+    if(index != NULL)
+    {
+        if(k >= index->length)
+        {
+            return 0;
+        }
+
+        if(!seekTrace(reader, (long)index->chunks[k / index->every].offset))
+        {
+            return 0;
+        }
+
+        skip = (unsigned long)index->chunks[k / index->every].skip + k % index->every;
+    }
+
+    while(skip > 0)
+    {
+        status = readTrace(reader, &access);
+        if(status != 1)
+        {
+            return status;
+        }
+        skip--;
+    }
+
+    return 1;
+}
+
+/* traceIndexEvery
+ * ...
+ */
+
+unsigned long traceIndexEvery(TraceIndex index)
+{
+    return index->every;
+}
+
+/* traceIndexLength
+ * ...
+ */
+
+unsigned long traceIndexLength(TraceIndex index)
+{
+    return index->length;
+}
+
+/* traceIndexChunks
+ * ...
+ */
+
+unsigned long traceIndexChunks(TraceIndex index)
+{
+    return index->numChunks;
+}
+
+/* traceIndexChunk
+ * ...
+ */
+
+const IndexChunk* traceIndexChunk(TraceIndex index, unsigned long chunk)
+{
+    return &index->chunks[chunk];
+}
@@ -0,0 +1,159 @@
+/* File: traceindex.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Trace index. indexTrace makes one pass over a text or binary trace and
+ * writes a sidecar file holding the byte offset of every N-th access
+ * together with a summary of each chunk of N accesses. With the index a
+ * reader can start at access K after reading at most N accesses
+ * (seekTraceIndex), and a trace can be cut into slices of whole chunks
+ * that are processed independently.
+ *
+ * The simulator looks for "<trace file>.idx" when --start is given.
+ *
+ * Index file layout (native byte order):
+ *
+ *      char[8]         "SIMIDX03"
+ *      uint64          accesses per chunk (N)
+ *      uint64          number of accesses
+ *      uint64          number of chunks (c)
+ *      uint64          size of the indexed trace file in bytes
+ *      uint64          its modification time, seconds
+ *      uint64          its modification time, nanoseconds
+ *      IndexChunk[c]   one entry per chunk, in trace order
+ */
+
+#ifndef SWIFT_TRACEINDEX_H_
+#define SWIFT_TRACEINDEX_H_
+
+#include <stdint.h>
+#include "trace.h"
+
+/* Accesses per chunk when none is given */
+#define INDEX_DEFAULT_EVERY 65536
+
+/* Typedefs */
+typedef struct TraceIndex_* TraceIndex;
+
+/* IndexChunk
+ *
+ * One chunk of the index.
+ *
+ * @param   offset          byte offset of the record holding the chunk's
+ *                          first access
+ * @param   skip            accesses of that record before the first one
+ *                          (a modify in a Lackey trace returns two)
+ * @param   writes          number of writes in the chunk
+ * @param   low             lowest address accessed in the chunk
+ * @param   high            highest address accessed in the chunk
+ */
+
+typedef struct IndexChunk_ {
+    uint64_t offset;
+    uint64_t skip;
+    uint64_t writes;
+    uint64_t low;
+    uint64_t high;
+} IndexChunk;
+
+
+/* indexTrace
+ *
+ * Writes the index for a trace. Prints the number of accesses and
+ * chunks. Returns 1 on success and 0 on failure (a bad trace or a
+ * failed write), in which case out is removed.
+ *
+ * @param   in              trace file name
+ * @param   out             index file name
+ * @param   every           accesses per chunk
+ *
+ * @return  success         1
+ * @return  failure         0
+ */
+
+int indexTrace(const char* in, const char* out, unsigned long every);
+
+/* loadTraceIndex
+ *
+ * Reads an index into memory. Fails if the file is not an index or if
+ * the trace has changed size or modification time since it was indexed.
+ * Returns the index on success and NULL on failure.
+ *
+ * @param   path            index file name
+ * @param   trace           name of the trace the index should describe
+ *
+ * @return  success         new TraceIndex
+ * @return  failure         NULL
+ */
+
+TraceIndex loadTraceIndex(const char* path, const char* trace);
+
+/* destroyTraceIndex
+ *
+ * Frees a loaded index. Passing NULL does nothing.
+ *
+ * @param   index           index to be destroyed
+ *
+ * @return  void
+ */
+
+void destroyTraceIndex(TraceIndex index);
+
+/* seekTraceIndex
+ *
+ * Positions reader so the next readTrace returns access k (counting
+ * from 0). Uses the index to jump to the chunk holding k, then reads
+ * forward. With a NULL index it just reads k accesses, so the reader
+ * must be freshly opened.
+ *
+ * @param   reader          reader open on the indexed trace
+ * @param   index           index of the trace, or NULL
+ * @param   k               access to position at
+ *
+ * @return  success         1
+ * @return  past the end    0
+ * @return  bad line        -1
+ */
+
+int seekTraceIndex(TraceReader reader, TraceIndex index, unsigned long k);
+
+/* traceIndexEvery
+ *
+ * @param   index           loaded index
+ *
+ * @return  unsigned long   accesses per chunk
+ */
+
+unsigned long traceIndexEvery(TraceIndex index);
+
+/* traceIndexLength
+ *
+ * @param   index           loaded index
+ *
+ * @return  unsigned long   number of accesses in the trace
+ */
+
+unsigned long traceIndexLength(TraceIndex index);
+
+/* traceIndexChunks
+ *
+ * @param   index           loaded index
+ *
+ * @return  unsigned long   number of chunks
+ */
+
+unsigned long traceIndexChunks(TraceIndex index);
+
+/* traceIndexChunk
+ *
+ * @param   index           loaded index
+ * @param   chunk           chunk number, below traceIndexChunks
+ *
+ * @return  IndexChunk*     the chunk's entry
+ */
+
+const IndexChunk* traceIndexChunk(TraceIndex index, unsigned long chunk);
+
+
+#endif
+/* SWIFT_TRACEINDEX_H_ */
@@ -0,0 +1,332 @@
+/* File: tracewriter.c
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Double buffered trace writer. See tracewriter.h for details.
+ *
+ * Table of Contents:
+ *      1. Includes
+ *      2. Structs
+ *          -TraceWriter
+ *      3. Utility Functions
+ *          -appendHex
+ *          -writerThread
+ *          -handOff
+ *      4. TraceWriter Functions
+ */
+
+/********************************
+ *     1. Includes              *
+ ********************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+#include "trace.h"
+#include "tracewriter.h"
+
+/* Size of each of the two buffers */
+#define WRITER_BUFFER_SIZE (1 << 20)
+
+/* Longest text record: two 16 digit numbers plus punctuation */
+#define WRITER_MAX_RECORD 64
+
+/********************************
+ *        2. Structs            *
+ ********************************/
+
+/* TraceWriter
+ *
+ * The simulation fills buffers[current]. When it is full it becomes the
+ * pending buffer and the writer thread writes it out; the simulation
+ * only waits if it fills the other buffer before that write finishes.
+ *
+ * @param   file            output file
+ * @param   format          TRACE_TEXT or TRACE_BINARY
+ * @param   buffers         the two buffers
+ * @param   current         buffer being filled
+ * @param   length          bytes used in the buffer being filled
+ * @param   pending         buffer waiting to be written (-1 = none)
+ * @param   pendingLength   bytes in the pending buffer
+ * @param   done            set when the thread should exit
+ * @param   failed          set when a write fails
+ * @param   count           records written
+ * @param   lock            protects pending, done and failed
+ * @param   wake            signalled when pending or done changes
+ * @param   thread          writer thread
+ */
+
+struct TraceWriter_ {
+    FILE* file;
+    int format;
+    char* buffers[2];
+    int current;
+    size_t length;
+    int pending;
+    size_t pendingLength;
+    int done;
+    int failed;
+    unsigned long count;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t thread;
+};
+
+/********************************
+ *     3. Utility Functions     *
+ ********************************/
+
+/* appendHex
+ *
+ * Writes value as 0x followed by at least digits hex digits and
+ * returns the number of characters written. Much cheaper than printf
+ * on the hot path.
+ */
+
+static int appendHex(char* out, unsigned long value, int digits)
+{
+    static const char hex[] = "0123456789abcdef";
+    char tmp[16];
+    int n, i;
+
+    n = 0;
+    do
+    {
+        tmp[n++] = hex[value & 15];
+        value = value >> 4;
+    } while(value != 0);
+
+    while(n < digits)
+    {
+        tmp[n++] = '0';
+    }
+
+    out[0] = '0';
+    out[1] = 'x';
+    for(i = 0; i < n; i++)
+    {
+        out[2 + i] = tmp[n - 1 - i];
+    }
+
+    return n + 2;
+}
+
+/* writerThread
+ *
+ * Waits for pending buffers and writes them out until told to stop.
+ */
+
+static void* writerThread(void* arg)
+{
+    TraceWriter writer;
+    int buffer, failed;
+    size_t length;
+
+    writer = (TraceWriter)arg;
+
+    pthread_mutex_lock(&writer->lock);
+
+    for(;;)
+    {
+        while(writer->pending == -1 && !writer->done)
+        {
+            pthread_cond_wait(&writer->wake, &writer->lock);
+        }
+
+        if(writer->pending == -1)
+        {
+            break;
+        }
+
+        buffer = writer->pending;
+        length = writer->pendingLength;
+
+        /* Write without holding the lock so the simulation can keep
+           filling the other buffer */
+        pthread_mutex_unlock(&writer->lock);
+        failed = (fwrite(writer->buffers[buffer], 1, length, writer->file) != length);
+        pthread_mutex_lock(&writer->lock);
+
+        writer->failed |= failed;
+        writer->pending = -1;
+        pthread_cond_broadcast(&writer->wake);
+    }
+
+    pthread_mutex_unlock(&writer->lock);
+
+    return NULL;
+}
+
+/* handOff
+ *
+ * Passes the current buffer to the writer thread and switches to the
+ * other one, waiting if that one is still being written.
+ */
+
+static void handOff(TraceWriter writer)
+{
+    pthread_mutex_lock(&writer->lock);
+
+    while(writer->pending != -1)
+    {
+        pthread_cond_wait(&writer->wake, &writer->lock);
+    }
+
+    writer->pending = writer->current;
+    writer->pendingLength = writer->length;
+    pthread_cond_broadcast(&writer->wake);
+
+    pthread_mutex_unlock(&writer->lock);
+
+    writer->current = 1 - writer->current;
+    writer->length = 0;
+}
+
+/********************************
+ *   4. TraceWriter Functions   *
+ ********************************/
+
+/* createTraceWriter
+ * ...
+ */
+
+TraceWriter createTraceWriter(const char* path, int format)
+{
+    TraceWriter writer;
+    FILE* file;
+
+    if(format != TRACE_TEXT && format != TRACE_BINARY)
+    {
+        fprintf(stderr, "Invalid trace format.\n");
+        return NULL;
+    }
+
+    file = fopen(path, "wb");
+    if(file == NULL)
+    {
+        fprintf(stderr, "Error: Could not open output file.\n");
+        return NULL;
+    }
+
+    writer = (TraceWriter)malloc(sizeof(struct TraceWriter_));
+    assert(writer != NULL);
+
+    writer->file = file;
+    writer->format = format;
+    writer->buffers[0] = (char*)malloc(WRITER_BUFFER_SIZE);
+    writer->buffers[1] = (char*)malloc(WRITER_BUFFER_SIZE);
+    assert(writer->buffers[0] != NULL && writer->buffers[1] != NULL);
+    writer->current = 0;
+    writer->length = 0;
+    writer->pending = -1;
+    writer->pendingLength = 0;
+    writer->done = 0;
+    writer->failed = 0;
+    writer->count = 0;
+
+    if(format == TRACE_BINARY)
+    {
+        memcpy(writer->buffers[0], TRACE_MAGIC, 8);
+        writer->length = 8;
+    }
+
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->wake, NULL);
+    pthread_create(&writer->thread, NULL, writerThread, writer);
+
+    return writer;
+}
+
+/* closeTraceWriter
+ * ...
+ */
+
+int closeTraceWriter(TraceWriter writer)
+{
+    int status;
+
+    status = 1;
+
+    if(writer != NULL)
+    {
+        if(writer->length > 0)
+        {
+            handOff(writer);
+        }
+
+        pthread_mutex_lock(&writer->lock);
+        writer->done = 1;
+        pthread_cond_broadcast(&writer->wake);
+        pthread_mutex_unlock(&writer->lock);
+
+        pthread_join(writer->thread, NULL);
+
+        pthread_mutex_destroy(&writer->lock);
+        pthread_cond_destroy(&writer->wake);
+        status = !writer->failed;
+        if(fclose(writer->file) != 0)
+        {
+            status = 0;
+        }
+        free(writer->buffers[0]);
+        free(writer->buffers[1]);
+        free(writer);
+    }
+
+    return status;
+}
+
+/* traceWrite
+ * ...
+ */
+
+void traceWrite(TraceWriter writer, unsigned long pc, unsigned long address, int write)
+{
+    char* out;
+    BinaryRecord record;
+
+    if(writer->length + WRITER_MAX_RECORD > WRITER_BUFFER_SIZE)
+    {
+        handOff(writer);
+    }
+
+    out = writer->buffers[writer->current] + writer->length;
+
+    if(writer->format == TRACE_BINARY)
+    {
+        record.pc = (uint64_t)pc;
+        record.address = (uint64_t)address;
+        record.size = 0;
+        record.op = write ? TRACE_WRITE : TRACE_READ;
+        memcpy(out, &record, sizeof(record));
+        writer->length += sizeof(record);
+    }
+    else
+    {
+        /* <pc>: <op> <address> */
+        out += appendHex(out, pc, 1);
+        out[0] = ':';
+        out[1] = ' ';
+        out[2] = write ? 'W' : 'R';
+        out[3] = ' ';
+        out += 4;
+        out += appendHex(out, address, 8);
+        *out++ = '\n';
+        writer->length = (size_t)(out - writer->buffers[writer->current]);
+    }
+
+    writer->count++;
+}
+
+/* traceWriterCount
+ * ...
+ */
+
+unsigned long traceWriterCount(TraceWriter writer)
+{
+    return writer->count;
+}
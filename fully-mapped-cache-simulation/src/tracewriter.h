@@ -0,0 +1,78 @@
+/* File: tracewriter.h
+ *
+ * Date Created: October 17th, 2026
+ *
+ * Trace writer. Writes accesses as a text or binary trace (see trace.h
+ * for both formats) that the simulator can read back in. Records are
+ * formatted into a large buffer; full buffers are handed to a
+ * background thread that writes them out while the simulation carries
+ * on filling the other buffer.
+ *
+ * The cache uses a writer to emit its miss and writeback stream (the
+ * --filter option), so a downstream cache level can be studied without
+ * re-simulating this one.
+ */
+
+#ifndef SWIFT_TRACEWRITER_H_
+#define SWIFT_TRACEWRITER_H_
+
+/* Typedefs */
+typedef struct TraceWriter_* TraceWriter;
+
+
+/* createTraceWriter
+ *
+ * Opens path for writing and starts the writer thread. Returns the new
+ * writer on success and NULL on failure.
+ *
+ * @param   path            output file name
+ * @param   format          TRACE_TEXT or TRACE_BINARY
+ *
+ * @return  success         new TraceWriter
+ * @return  failure         NULL
+ */
+
+TraceWriter createTraceWriter(const char* path, int format);
+
+/* closeTraceWriter
+ *
+ * Writes out everything still buffered, stops the writer thread, closes
+ * the file and frees the writer. Passing NULL does nothing. Fails if
+ * any write or closing the file failed, leaving the trace incomplete.
+ *
+ * @param   writer          writer to be closed
+ *
+ * @return  success         1
+ * @return  failure         0
+ */
+
+int closeTraceWriter(TraceWriter writer);
+
+/* traceWrite
+ *
+ * Appends one access to the trace.
+ *
+ * @param   writer          target writer
+ * @param   pc              address of the instruction making the access
+ * @param   address         byte address accessed
+ * @param   write           0 = read, 1 = write
+ *
+ * @return  void
+ */
+
+void traceWrite(TraceWriter writer, unsigned long pc, unsigned long address, int write);
+
+/* traceWriterCount
+ *
+ * Returns the number of records written so far.
+ *
+ * @param   writer          target writer
+ *
+ * @return  unsigned long   number of records
+ */
+
+unsigned long traceWriterCount(TraceWriter writer);
+
+
+#endif
+/* SWIFT_TRACEWRITER_H_ */